@@ -0,0 +1,27 @@
+/*
+ * all.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_ALL_HPP_
+#define BENCHMARKS_ALL_HPP_
+
+#include "Benchmarks/bench_scheduler.hpp"
+#include "Benchmarks/bench_batch.hpp"
+#include "Benchmarks/bench_sockets.hpp"
+#include "Benchmarks/bench_wakeup.hpp"
+#include "Benchmarks/bench_parallel.hpp"
+#include "Benchmarks/bench_pipeline.hpp"
+#include "Benchmarks/bench_incremental.hpp"
+#include "Benchmarks/bench_editing.hpp"
+#include "Benchmarks/bench_frozen.hpp"
+#include "Benchmarks/bench_fusion.hpp"
+#include "Benchmarks/bench_allocations.hpp"
+#include "Benchmarks/bench_arena.hpp"
+#include "Benchmarks/bench_pool.hpp"
+#include "Benchmarks/bench_startup.hpp"
+
+#endif /* BENCHMARKS_ALL_HPP_ */
@@ -0,0 +1,111 @@
+/*
+ * bench_allocations.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_ALLOCATIONS_HPP_
+#define BENCHMARKS_BENCH_ALLOCATIONS_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/move.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+#include <vector>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Allocations and time per socket for the small flow types cells declare
+ * by the thousand, with a Batch for reference. Socket storage belongs to
+ * the engine, which keeps every value in a heap holder: make and copy show
+ * what that costs, small types included. Types with an inline copy (see
+ * copy_inline) also show the transfer the executors use between existing
+ * sockets, which does not allocate.
+ */
+BENCHMARK(Allocations, Flow_sockets)
+{
+    const std::size_t count = 100000;
+    Table table({"type", "operation", "allocs/socket", "ns/socket"});
+    auto measure = [&](const std::string &type, cellsocket_ptr (*make)())
+    {
+        std::vector<cellsocket_ptr> sockets;
+        sockets.reserve(count);
+        std::uint64_t allocs = 0;
+        double us = time_us([&](){
+            allocs = count_allocations([&](){
+                for(std::size_t k = 0; k < count; k++)
+                {
+                    sockets.push_back(make());
+                }
+            });
+        });
+        table << type << "make" << static_cast<double>(allocs) / count << us * 1000.0 / count;
+
+        cellsocket_ptr source = make();
+        us = time_us([&](){
+            allocs = count_allocations([&](){
+                for(const cellsocket_ptr &s: sockets)
+                {
+                    s << source;
+                }
+            });
+        });
+        table << type << "copy" << static_cast<double>(allocs) / count << us * 1000.0 / count;
+
+        TesterCell::SocketMover copy = TesterCell::inline_copy_for(*source);
+        if(!copy)
+        {
+            return;
+        }
+        us = time_us([&](){
+            allocs = count_allocations([&](){
+                for(const cellsocket_ptr &s: sockets)
+                {
+                    copy(*s, *source);
+                }
+            });
+        });
+        table << type << "copy inline" << static_cast<double>(allocs) / count << us * 1000.0 / count;
+    };
+    measure("bool", [](){ return make_cellsocket<bool>(); });
+    measure("int", [](){ return make_cellsocket<int>(); });
+    measure("float", [](){ return make_cellsocket<float>(); });
+    measure("ReturnCode", [](){ return make_cellsocket<ReturnCode>(); });
+    measure("Batch", [](){ return make_cellsocket<TesterCell::Batch>(); });
+}
+
+/**
+ * Allocations per cell to build and to run a Start -> If -> Print control
+ * chain, whose sockets are all bool and ReturnCode. Building allocates a
+ * holder per declared socket; nothing in the plugin changes that.
+ */
+BENCHMARK(Allocations, Control_circuit)
+{
+    Table table({"cells", "allocs/cell build", "allocs/cell pid"});
+    for(std::size_t n: sizes())
+    {
+        std::uint64_t before = allocations();
+        circuit_graph_ptr g = linear_chain(CHAIN_CONTROL, n);
+        g->circuit()->configure_all();
+        std::uint64_t build = allocations() - before;
+        SilenceStdout quiet;
+        Scheduler s(g->circuit());
+        s.execute(1);
+        std::uint64_t run = count_allocations([&](){
+            s.execute(1);
+        });
+        table << n << static_cast<double>(build) / n << static_cast<double>(run) / n;
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_ALLOCATIONS_HPP_ */
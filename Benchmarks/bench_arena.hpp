@@ -0,0 +1,74 @@
+/*
+ * bench_arena.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_ARENA_HPP_
+#define BENCHMARKS_BENCH_ARENA_HPP_
+
+#include "Engine/all.hpp"
+#include "benchmark.hpp"
+#include "TesterCell/arena.h"
+#include "TesterCell/generator.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Load time, allocations and resident memory of a generated circuit of up
+ * to 100k cells, with every cell cloned on the heap and with every cell
+ * made in one CellArena. The heap circuit is kept alive while the arena
+ * circuit is built so neither reuses memory the other freed.
+ */
+BENCHMARK(Arena, Load_generated_circuit)
+{
+    Table table({"cells", "cells in", "load ms", "allocs/cell", "RSS MB", "free ms"});
+    TesterCell::GeneratorOptions opts;
+    opts.cells = std::min<std::size_t>(100000, options().max_cells);
+    opts.fan_in = 1.5;
+
+    struct Load
+    {
+        TesterCell::circuit_graph_ptr graph;
+        double load_us;
+        std::uint64_t allocs;
+        std::size_t rss;
+    };
+    auto load = [&]()
+    {
+        Load l;
+        std::size_t rss = rss_bytes();
+        l.load_us = time_us([&](){
+            l.allocs = count_allocations([&](){
+                l.graph = TesterCell::CircuitGenerator(opts).generate();
+            });
+        });
+        l.rss = rss_bytes() - rss;
+        return l;
+    };
+    Load heap = load();
+    opts.arena = std::make_shared<TesterCell::CellArena>();
+    Load arena = load();
+    opts.arena.reset(); //the cells now hold the only references
+
+    for(Load *l: {&heap, &arena})
+    {
+        double free_us = time_us([&](){ l->graph.reset(); });
+        table << opts.cells << (l == &heap ? "heap" : "arena") << l->load_us / 1000.0
+              << static_cast<double>(l->allocs) / opts.cells
+              << l->rss / 1048576.0 << free_us / 1000.0;
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_ARENA_HPP_ */
@@ -0,0 +1,168 @@
+/*
+ * bench_batch.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_BATCH_HPP_
+#define BENCHMARKS_BENCH_BATCH_HPP_
+
+#include "Engine/all.hpp"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+#include "TesterCell/batch.h"
+#include "TesterCell/dataflow.h"
+#include "TesterCell/shared.h"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Adds 2^20 pairs of doubles, once through the scalar Add cell (one
+ * process() per element) and once through BatchAdd at several batch sizes.
+ */
+BENCHMARK(Batch, Add_vs_scalar)
+{
+    const std::size_t elements = 1 << 20;
+    std::printf("kernels: %s\n", TesterCell::kernels::isa());
+    Table table({"cell", "batch", "ns/element", "speedup"});
+
+    cell_ptr scalar = prototype<Add>();
+    scalar->inputs["left"] << 1.0;
+    scalar->inputs["right"] << 2.0;
+    double scalar_us = time_us([&](){
+        for(std::size_t k = 0; k < elements; k++)
+        {
+            scalar->inputs["left"] << static_cast<double>(k);
+            scalar->process();
+        }
+    });
+    table << "Add" << std::size_t(1) << scalar_us * 1000.0 / elements << 1.0;
+
+    for(std::size_t batch: {16, 256, 4096, 65536})
+    {
+        cell_ptr c = prototype<TesterCell::BatchAdd>();
+        TesterCell::Batch left(batch), right(batch, 2.0);
+        c->inputs["right"] << right;
+        double us = time_us([&](){
+            for(std::size_t k = 0; k < elements; k += batch)
+            {
+                left[0] = static_cast<double>(k);
+                c->inputs["left"] << left;
+                c->process();
+            }
+        });
+        table << "BatchAdd" << batch << us * 1000.0 / elements << scalar_us / us;
+    }
+}
+
+BENCHMARK(Batch, Kernels)
+{
+    const std::size_t n = 4096;
+    const int reps = 4096;
+    TesterCell::Batch a(n, 1.5), b(n, 2.5), c(n, 0.5), out(n);
+    Table table({"kernel", "ns/element"});
+    double us = time_us([&](){
+        for(int r = 0; r < reps; r++)
+        {
+            for(std::size_t k = 0; k < n; k++) out[k] = a[k] + b[k];
+        }
+    });
+    table << "loop add" << us * 1000.0 / (n * reps);
+    us = time_us([&](){
+        for(int r = 0; r < reps; r++)
+        {
+            TesterCell::kernels::add(a.data(), b.data(), out.data(), n);
+        }
+    });
+    table << "add" << us * 1000.0 / (n * reps);
+    us = time_us([&](){
+        for(int r = 0; r < reps; r++)
+        {
+            TesterCell::kernels::multiply_add(a.data(), b.data(), c.data(), out.data(), n);
+        }
+    });
+    table << "multiply_add" << us * 1000.0 / (n * reps);
+}
+
+/**
+ * A chain of BatchAdd cells carrying 2^20 doubles, with every connection
+ * deep copied and with single-consumer connections moved.
+ */
+BENCHMARK(Batch, Move_vs_copy)
+{
+    const std::size_t width = 1 << 20;
+    Table table({"cells", "transfer", "ms/pid", "speedup"});
+    cell_ptr proto = prototype<TesterCell::BatchAdd>();
+    proto->inputs["left"] << TesterCell::Batch(width, 1.0);
+    proto->inputs["right"] << TesterCell::Batch(width, 1.0);
+    for(std::size_t n: {2, 10, 50})
+    {
+        CircuitGraph b;
+        std::size_t prev = b.insert(proto->clone());
+        for(std::size_t k = 1; k < n; k++)
+        {
+            std::size_t next = b.insert(proto->clone());
+            b.connect(prev, "out", next, "left");
+            prev = next;
+        }
+        const int pids = 20;
+        TesterCell::DataflowExecutor exec(b);
+        exec.execute(1);
+        double copy = time_us([&](){ exec.execute(pids); });
+        exec.move_single_consumer(true);
+        exec.execute(1);
+        double move = time_us([&](){ exec.execute(pids); });
+        table << n << "copy" << copy / pids / 1000.0 << 1.0;
+        table << n << "move" << move / pids / 1000.0 << copy / move;
+    }
+}
+
+/**
+ * One 2^20 element batch read by n consumers, copied into every input as a
+ * Batch and shared by all of them as a SharedBatch from a Broadcast.
+ */
+BENCHMARK(Batch, Shared_fan_out)
+{
+    const std::size_t width = 1 << 20;
+    Table table({"consumers", "payload", "ms/pid", "speedup"});
+    cell_ptr add = prototype<TesterCell::BatchAdd>();
+    add->inputs["left"] << TesterCell::Batch(width, 1.0);
+    add->inputs["right"] << TesterCell::Batch(width, 1.0);
+    cell_ptr broadcast = prototype<TesterCell::Broadcast>();
+    cell_ptr copied = prototype<Front<TesterCell::Batch>>();
+    cell_ptr shared = prototype<Front<TesterCell::SharedBatch, TesterCell::Batch>>();
+    for(std::size_t n: {1, 8, 64})
+    {
+        const int pids = 10;
+        CircuitGraph c;
+        std::size_t source = c.insert(add->clone());
+        for(std::size_t k = 0; k < n; k++)
+        {
+            c.connect(source, "out", c.insert(copied->clone()), "in");
+        }
+        CircuitGraph s;
+        std::size_t producer = s.insert(broadcast->clone());
+        s.connect(s.insert(add->clone()), "out", producer, "in");
+        for(std::size_t k = 0; k < n; k++)
+        {
+            s.connect(producer, "out", s.insert(shared->clone()), "in");
+        }
+        TesterCell::DataflowExecutor copy_exec(c), shared_exec(s);
+        copy_exec.execute(1);
+        shared_exec.execute(1);
+        double copy = time_us([&](){ copy_exec.execute(pids); });
+        double share = time_us([&](){ shared_exec.execute(pids); });
+        table << n << "Batch" << copy / pids / 1000.0 << 1.0;
+        table << n << "SharedBatch" << share / pids / 1000.0 << copy / share;
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_BATCH_HPP_ */
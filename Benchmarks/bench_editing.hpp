@@ -0,0 +1,58 @@
+/*
+ * bench_editing.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_EDITING_HPP_
+#define BENCHMARKS_BENCH_EDITING_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/dataflow.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Cost of one UI edit (insert a cell, connect it, drop an old connection)
+ * when the execution state is rebuilt against when it is patched.
+ */
+BENCHMARK(Editing, Rebuild_vs_patch)
+{
+    SilenceStdout quiet;
+    Table table({"cells", "executor us", "rebuild us", "patch us", "speedup"});
+    cell_ptr proto = prototype<Add>();
+    for(std::size_t n: sizes())
+    {
+        circuit_graph_ptr b = random_dag(n, 42);
+        double executor = time_us([&](){ TesterCell::DataflowExecutor exec(*b); });
+        TesterCell::Dataflow flow(*b, true);
+        std::size_t anchor = b->insert(proto->clone());
+        flow.sync(*b);
+
+        Samples rebuild, patch;
+        const int edits = 20;
+        for(int e = 0; e < edits; e++)
+        {
+            std::size_t k = b->insert(proto->clone());
+            b->connect(anchor, "out", k, "left");
+            const TesterCell::Connection c = b->connections().front();
+            b->disconnect(c.from, c.output, c.to, c.input);
+            patch.add(time_us([&](){ flow.sync(*b); }));
+            rebuild.add(time_us([&](){ TesterCell::Dataflow fresh(*b); }));
+        }
+        table << n << executor << rebuild.mean() << patch.mean()
+              << rebuild.mean() / patch.mean();
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_EDITING_HPP_ */
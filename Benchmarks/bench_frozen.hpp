@@ -0,0 +1,68 @@
+/*
+ * bench_frozen.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_FROZEN_HPP_
+#define BENCHMARKS_BENCH_FROZEN_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/frozen.h"
+#include "bench_scheduler.hpp"
+
+#include <memory>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Per cell cost of the Scheduler, the dynamic DataflowExecutor and a
+ * FrozenSchedule on the same circuit.
+ */
+inline void frozen_vs_dynamic(Table &table, const std::string &shape, CircuitGraph &b)
+{
+    SilenceStdout quiet;
+    std::size_t n = b.size();
+    int pids = pids_for(n);
+    double freeze = 0;
+    double frozen = 0, dynamic = 0, scheduled = 0;
+    {
+        std::unique_ptr<TesterCell::FrozenSchedule> f;
+        freeze = time_us([&](){ f.reset(new TesterCell::FrozenSchedule(b)); });
+        frozen = time_us([&](){ f->execute(pids); });
+    }
+    {
+        TesterCell::DataflowExecutor exec(b);
+        dynamic = time_us([&](){ exec.execute(pids); });
+    }
+    {
+        Scheduler sched(b.circuit());
+        scheduled = time_us([&](){ sched.execute(pids); });
+    }
+    double cells = static_cast<double>(n) * pids / 1000.0; //us -> ns per cell
+    table << shape << n << static_cast<std::size_t>(pids) << freeze
+          << scheduled / cells << dynamic / cells << frozen / cells
+          << dynamic / frozen;
+}
+
+BENCHMARK(Frozen, Chains_and_dags)
+{
+    Table table({"shape", "cells", "pids", "freeze us", "Scheduler ns/cell",
+                 "dynamic ns/cell", "frozen ns/cell", "speedup"});
+    for(std::size_t n: sizes())
+    {
+        frozen_vs_dynamic(table, "Add chain", *linear_chain(CHAIN_ADD, n));
+        frozen_vs_dynamic(table, "Operation chain", *linear_chain(CHAIN_OPERATION, n));
+        frozen_vs_dynamic(table, "random dag", *random_dag(n, 42));
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_FROZEN_HPP_ */
@@ -0,0 +1,64 @@
+/*
+ * bench_fusion.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_FUSION_HPP_
+#define BENCHMARKS_BENCH_FUSION_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/fusion.h"
+#include "bench_scheduler.hpp"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Dispatch cost per cell with and without fusing linear chains.
+ */
+BENCHMARK(Fusion, Control_flow_chains)
+{
+    Table table({"shape", "cells", "units", "pids", "dataflow ns/cell",
+                 "fused ns/cell", "speedup"});
+    for(ChainKind kind: {CHAIN_CONTROL, CHAIN_ADD})
+    {
+        for(std::size_t n: sizes())
+        {
+            SilenceStdout quiet;
+            circuit_graph_ptr b = linear_chain(kind, n);
+            int pids = pids_for(n);
+            TesterCell::DataflowExecutor dynamic(*b);
+            double d = time_us([&](){ dynamic.execute(pids); });
+            TesterCell::FusedExecutor fused(*b);
+            double f = time_us([&](){ fused.execute(pids); });
+            double cells = static_cast<double>(n) * pids / 1000.0;
+            table << chain_name(kind) << n << fused.units()
+                  << static_cast<std::size_t>(pids) << d / cells << f / cells << d / f;
+        }
+    }
+    Table dags({"shape", "cells", "units", "pids", "dataflow ns/cell",
+                "fused ns/cell", "speedup"});
+    for(std::size_t n: sizes())
+    {
+        SilenceStdout quiet;
+        circuit_graph_ptr b = random_dag(n, 42);
+        int pids = pids_for(n);
+        TesterCell::DataflowExecutor dynamic(*b);
+        double d = time_us([&](){ dynamic.execute(pids); });
+        TesterCell::FusedExecutor fused(*b);
+        double f = time_us([&](){ fused.execute(pids); });
+        double cells = static_cast<double>(n) * pids / 1000.0;
+        dags << "random dag" << n << fused.units()
+             << static_cast<std::size_t>(pids) << d / cells << f / cells << d / f;
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_FUSION_HPP_ */
@@ -0,0 +1,73 @@
+/*
+ * bench_incremental.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_INCREMENTAL_HPP_
+#define BENCHMARKS_BENCH_INCREMENTAL_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/incremental.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+#include <random>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Re-run after changing one constant: the whole circuit (touch_all) against
+ * only the cone below the changed cell. The changed cell is picked at
+ * random, so the cone size varies from row to row.
+ */
+BENCHMARK(Incremental, One_constant)
+{
+    SilenceStdout quiet;
+    Table table({"shape", "cells", "cone", "full ms", "incremental ms", "speedup"});
+    std::mt19937 rng(3);
+    for(std::size_t n: sizes())
+    {
+        if(n < 1000)
+        {
+            continue;
+        }
+        for(int shape = 0; shape < 2; shape++)
+        {
+            circuit_graph_ptr b = shape ? random_dag(n, 42) : linear_chain(CHAIN_ADD, n);
+            TesterCell::IncrementalExecutor exec(*b);
+            exec.execute();
+
+            exec.touch_all();
+            double full = time_us([&](){ exec.execute(); });
+
+            //Add and Operation both take a second operand that is a constant
+            std::size_t k = rng() % n;
+            std::uint64_t before = exec.stats().processed;
+            double incremental = time_us([&](){
+                if((*b)[k]->inputs.count("right"))
+                {
+                    (*b)[k]->inputs["right"] << 2.0;
+                }
+                else
+                {
+                    (*b)[k]->inputs["b"] << 2;
+                }
+                exec.execute();
+            });
+            table << (shape ? "random dag" : "Add chain") << n
+                  << static_cast<std::size_t>(exec.stats().processed - before)
+                  << full / 1000.0 << incremental / 1000.0 << full / incremental;
+        }
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_INCREMENTAL_HPP_ */
@@ -0,0 +1,70 @@
+/*
+ * bench_parallel.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_PARALLEL_HPP_
+#define BENCHMARKS_BENCH_PARALLEL_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/work_stealing.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+#include <thread>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Runs b on 1, 2, 4 ... 64 workers and prints the speedup over one worker.
+ * Counts above the number of cores are still run to show oversubscription.
+ */
+inline void speedup(Table &table, const std::string &shape, CircuitGraph &b, int pids)
+{
+    SilenceStdout quiet;
+    double base = 0;
+    for(unsigned threads: {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+    {
+        TesterCell::WorkStealingExecutor exec(b, threads);
+        exec.execute(1); //warm up
+        double us = time_us([&](){ exec.execute(pids); });
+        if(threads == 1)
+        {
+            base = us;
+        }
+        table << shape << b.size() << static_cast<std::size_t>(threads)
+              << us / pids / 1000.0 << base / us << base / us / threads
+              << static_cast<double>(exec.steals()) / (pids + 1);
+    }
+}
+
+BENCHMARK(Parallel, Fan_out_speedup)
+{
+    Table table({"shape", "cells", "threads", "ms/pid", "speedup",
+                 "efficiency", "steals/pid"});
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::size_t n = std::min<std::size_t>(1025, options().max_cells);
+    speedup(table, "batch fan-out", *batch_fan_out(n, 16384), std::max(1, std::min(options().pids, 20)));
+
+    TesterCell::GeneratorOptions opts;
+    opts.seed = 7;
+    opts.cells = std::min<std::size_t>(10000, options().max_cells);
+    opts.fan_in = 1.0;
+    opts.max_fan_out = 32;
+    opts.mix.pause = 0;
+    opts.mix.branch = 0;
+    opts.mix.print = 0;
+    speedup(table, "generated", *TesterCell::CircuitGenerator(opts).generate(),
+            std::max(1, std::min(options().pids, 20)));
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_PARALLEL_HPP_ */
@@ -0,0 +1,59 @@
+/*
+ * bench_pipeline.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_PIPELINE_HPP_
+#define BENCHMARKS_BENCH_PIPELINE_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/pipeline.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * A 20 stage chain of Pause cells, 1ms each except one 3ms stage.
+ * Lock-step execution costs the sum of all stages per pid (22ms), a full
+ * pipeline should approach the slowest stage (3ms).
+ */
+BENCHMARK(Pipeline, Chain_throughput)
+{
+    SilenceStdout quiet;
+    Table table({"executor", "stages", "depth", "ms/pid", "pids/s"});
+    circuit_graph_ptr b = linear_chain(CHAIN_PAUSE, 20);
+    for(std::size_t k = 0; k < b->size(); k++)
+    {
+        (*b)[k]->inputs["milliseconds"] << (k == 10 ? 3 : 1);
+    }
+    const int pids = std::max(1, std::min(options().pids, 50));
+
+    {
+        TesterCell::DataflowExecutor exec(*b);
+        double us = time_us([&](){ exec.execute(pids); });
+        table << "Dataflow" << static_cast<std::size_t>(1) << static_cast<std::size_t>(0)
+              << us / pids / 1000.0 << pids / (us / 1e6);
+    }
+    for(std::size_t stages: {2, 5, 10, 20})
+    {
+        for(std::size_t depth: {1, 4})
+        {
+            TesterCell::PipelineExecutor exec(*b, stages, depth);
+            double us = time_us([&](){ exec.execute(pids); });
+            table << "Pipeline" << stages << depth
+                  << us / pids / 1000.0 << pids / (us / 1e6);
+        }
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_PIPELINE_HPP_ */
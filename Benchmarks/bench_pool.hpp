@@ -0,0 +1,77 @@
+/*
+ * bench_pool.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_POOL_HPP_
+#define BENCHMARKS_BENCH_POOL_HPP_
+
+#include "Engine/all.hpp"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+#include "TesterCell/pool.h"
+
+#include <vector>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Spawning and deleting cells the way an editor does, 1000 at a time,
+ * with clone() and with a CellPool.
+ */
+BENCHMARK(Pool, Spawn_and_delete)
+{
+    const std::size_t batch = 1000;
+    const int rounds = 20;
+    Table table({"cell", "cells from", "ns/cell", "allocs/cell", "speedup"});
+    auto measure = [&](const std::string &name, const cell_ptr &proto)
+    {
+        std::vector<cell_ptr> cells;
+        cells.reserve(batch);
+        std::uint64_t allocs = 0;
+        double cloned = time_us([&](){
+            allocs = count_allocations([&](){
+                for(int r = 0; r < rounds; r++)
+                {
+                    for(std::size_t k = 0; k < batch; k++)
+                    {
+                        cells.push_back(proto->clone());
+                    }
+                    cells.clear();
+                }
+            });
+        });
+        const double per = 1.0 / (rounds * batch);
+        table << name << "clone" << cloned * 1000.0 * per << allocs * per << 1.0;
+
+        TesterCell::CellPool pool(proto, batch);
+        pool.reserve(batch);
+        double pooled = time_us([&](){
+            allocs = count_allocations([&](){
+                for(int r = 0; r < rounds; r++)
+                {
+                    for(std::size_t k = 0; k < batch; k++)
+                    {
+                        cells.push_back(pool.acquire());
+                    }
+                    cells.clear();
+                }
+            });
+        });
+        table << name << "pool" << pooled * 1000.0 * per << allocs * per << cloned / pooled;
+    };
+    measure("Add", prototype<Add>());
+    measure("If", prototype<TesterCell::If>());
+    measure("Print", prototype<TesterCell::Print>());
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_POOL_HPP_ */
@@ -0,0 +1,121 @@
+/*
+ * bench_scheduler.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_SCHEDULER_HPP_
+#define BENCHMARKS_BENCH_SCHEDULER_HPP_
+
+#include "Engine/all.hpp"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Number of pids to run for a circuit of n cells, so the largest circuits
+ * still finish in a reasonable time.
+ */
+inline int pids_for(std::size_t n)
+{
+    int budget = static_cast<int>(1000000 / n);
+    return std::max(1, std::min(options().pids, budget));
+}
+
+inline Table scheduler_table()
+{
+    return Table({"shape", "cells", "pids", "tokens/s",
+                  "p50 us/pid", "p99 us/pid", "bare us/pid", "ovh ns/cell"});
+}
+
+/**
+ * Runs one circuit three ways and prints a row:
+ *  - bare:       every cell's process(pid) called directly in insertion order
+ *  - throughput: Scheduler::execute(pids) in one call
+ *  - latency:    Scheduler::execute(1) timed pid by pid
+ * The scheduler overhead per cell is the scheduled time per pid minus the
+ * bare time per pid, divided by the number of cells.
+ */
+inline void measure(Table &table, const std::string &shape, CircuitGraph &b)
+{
+    SilenceStdout quiet;
+    std::size_t n = b.size();
+    int pids = pids_for(n);
+    b.circuit()->configure_all();
+
+    double bare = time_us([&](){
+        for(int pid = 0; pid < pids; pid++)
+        {
+            for(const cell_ptr &c: b.cells())
+            {
+                c->process(pid);
+            }
+        }
+    });
+
+    Scheduler sched(b.circuit());
+    double total = time_us([&](){ sched.execute(pids); });
+
+    Samples latency;
+    for(int pid = 0; pid < pids; pid++)
+    {
+        latency.add(time_us([&](){ sched.execute(1); }));
+    }
+
+    double bare_per_pid = bare / pids;
+    double overhead_ns = (latency.mean() - bare_per_pid) * 1000.0 / n;
+    table << shape << n << static_cast<std::size_t>(pids)
+          << pids / (total / 1e6)
+          << latency.percentile(0.5) << latency.percentile(0.99)
+          << bare_per_pid << overhead_ns;
+}
+
+BENCHMARK(Scheduler, Linear_chain)
+{
+    Table table = scheduler_table();
+    for(ChainKind kind: {CHAIN_ADD, CHAIN_OPERATION, CHAIN_PAUSE, CHAIN_CONTROL})
+    {
+        for(std::size_t n: sizes())
+        {
+            measure(table, chain_name(kind), *linear_chain(kind, n));
+        }
+    }
+}
+
+BENCHMARK(Scheduler, Fan_out)
+{
+    Table table = scheduler_table();
+    for(std::size_t n: sizes())
+    {
+        measure(table, "fan-out", *fan_out(n));
+    }
+}
+
+BENCHMARK(Scheduler, Diamonds)
+{
+    Table table = scheduler_table();
+    for(std::size_t n: sizes())
+    {
+        measure(table, "diamonds", *diamonds(n));
+    }
+}
+
+BENCHMARK(Scheduler, Random_dag)
+{
+    Table table = scheduler_table();
+    for(std::size_t n: sizes())
+    {
+        measure(table, "random dag", *random_dag(n, 42));
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_SCHEDULER_HPP_ */
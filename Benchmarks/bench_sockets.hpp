@@ -0,0 +1,180 @@
+/*
+ * bench_sockets.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_SOCKETS_HPP_
+#define BENCHMARKS_BENCH_SOCKETS_HPP_
+
+#include "Engine/all.hpp"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+#include "TesterCell/socket_keys.h"
+
+#include <string>
+#include <vector>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * What If::process costs with string lookups on every call versus socket
+ * handles bound once in configure, on the sockets of a real If cell.
+ */
+BENCHMARK(Sockets, If_lookup_vs_handles)
+{
+    const int calls = 1000000;
+    cell_ptr c = prototype<TesterCell::If>();
+    c->inputs["condition"] << true;
+    c->inputs[">>"] << Quantum::OK;
+    c->configure();
+    const CellSockets &i = c->inputs;
+    const CellSockets &o = c->outputs;
+
+    double lookup = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            if(i.get<bool>("condition"))
+            {
+                o["true >>"] << Quantum::OK;
+            }
+            else
+            {
+                o["false >>"] << Quantum::OK;
+            }
+        }
+    });
+
+    SocketHandle<bool> condition = i["condition"];
+    cellsocket_ptr true_out = o["true >>"], false_out = o["false >>"];
+    double bound = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            if(*condition)
+            {
+                true_out << Quantum::OK;
+            }
+            else
+            {
+                false_out << Quantum::OK;
+            }
+        }
+    });
+
+    double cell = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            c->process();
+        }
+    });
+
+    Table table({"access", "ns/process", "saving ns"});
+    table << "string lookup" << lookup * 1000.0 / calls << 0.0;
+    table << "bound handles" << bound * 1000.0 / calls << (lookup - bound) * 1000.0 / calls;
+    table << "If::process" << cell * 1000.0 / calls << 0.0;
+}
+
+/**
+ * Typed reads and writes as in the SyntacticSugar tests, through the
+ * string API, through a socket already looked up (which still checks the
+ * type on every access) and through a SocketTable, an array lookup and a
+ * type id compare followed by the socket's own access.
+ */
+BENCHMARK(Sockets, Typed_access)
+{
+    const int calls = 1000000;
+    CellSockets ts;
+    ts.declare<int>("x", "doc", 0);
+    ts.declare<float>("y", "doc", 0.0f);
+    ts.declare<std::string>("z", "doc", std::string("z"));
+    cellsocket_ptr x = ts["x"], y = ts["y"];
+    TesterCell::SocketKey kx("x"), ky("y");
+    TesterCell::SocketTable t(ts);
+    volatile float sink = 0;
+
+    double by_name = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            ts.get<int>("x") = k;
+            sink = ts.get<float>("y") + ts.get<int>("x");
+        }
+    });
+    double by_socket = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            x->get<int>() = k;
+            sink = y->get<float>() + x->get<int>();
+        }
+    });
+    double by_key = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            t.get<int>(kx) = k;
+            sink = t.get<float>(ky) + t.get<int>(kx);
+        }
+    });
+    double same_type = time_us([&](){
+        for(int k = 0; k < calls; k++)
+        {
+            sink = x->same_type(*y);
+        }
+    });
+    (void)sink;
+
+    Table table({"access", "ns/3 accesses"});
+    table << "get<T>(name)" << by_name * 1000.0 / calls;
+    table << "socket->get<T>()" << by_socket * 1000.0 / calls;
+    table << "table.get<T>(key)" << by_key * 1000.0 / calls;
+    table << "same_type" << same_type * 1000.0 / calls;
+}
+
+/**
+ * Socket lookup by name and by SocketKey on CellSockets holding 2, 20 and
+ * 200 sockets, every socket looked up in turn.
+ */
+BENCHMARK(Sockets, Keyed_lookup)
+{
+    const std::size_t lookups = 1000000;
+    Table table({"sockets", "ns/name lookup", "ns/key lookup", "speedup"});
+    for(std::size_t n: {2, 20, 200})
+    {
+        CellSockets ts;
+        std::vector<std::string> names;
+        std::vector<TesterCell::SocketKey> keys;
+        for(std::size_t k = 0; k < n; k++)
+        {
+            names.push_back("socket " + std::to_string(k));
+            keys.push_back(TesterCell::SocketKey(names.back()));
+            ts.declare<double>(names.back(), "doc", 0.0);
+        }
+        const CellSockets &cts = ts;
+        TesterCell::SocketTable t(ts);
+        const CellSocket * volatile last = nullptr;
+
+        double by_name = time_us([&](){
+            for(std::size_t k = 0; k < lookups; k++)
+            {
+                last = cts[names[k % n]].get();
+            }
+        });
+        double by_key = time_us([&](){
+            for(std::size_t k = 0; k < lookups; k++)
+            {
+                last = t[keys[k % n]].get();
+            }
+        });
+        (void)last;
+        table << n << by_name * 1000.0 / lookups << by_key * 1000.0 / lookups
+                << by_name / by_key;
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_SOCKETS_HPP_ */
@@ -0,0 +1,64 @@
+/*
+ * bench_startup.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_STARTUP_HPP_
+#define BENCHMARKS_BENCH_STARTUP_HPP_
+
+#include "Engine/all.hpp"
+#include "Engine/kernel.h"
+#include "benchmark.hpp"
+#include "testercell.h"
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Plugin registration cost against the number of cell types: each entry
+ * of the registration table is made and initialized in turn, as
+ * register_cells() does, and the running total is reported. A whole
+ * register_cells() into the kernel is timed next, and with --plugin the
+ * kernel's loadPlugin() of that library last.
+ *
+ * Every cell type is built and initialized at registration, so all three
+ * grow linearly with the table: the engine's registry only accepts built
+ * cells, there is no factory to defer to.
+ */
+BENCHMARK(Startup, Register_plugin)
+{
+    std::size_t count = 0;
+    const TesterCell::CellEntry *entries = TesterCell::plugin_cells(count);
+    Table table({"cells", "cell", "us", "total us"});
+    double total = 0;
+    for(std::size_t k = 0; k < count; k++)
+    {
+        double us = time_us([&](){
+            cell_ptr c = entries[k].make(entries[k]);
+            c->init();
+        });
+        total += us;
+        table << k + 1 << entries[k].name << us << total;
+    }
+
+    double plugin = time_us([&](){ TesterCell::register_cells(*Kernel::getKernel()); });
+    std::printf("register_cells: %.3f us for %zu cells, %.3f us/cell\n",
+            plugin, count, plugin / count);
+
+    if(!options().plugin.empty())
+    {
+        double load = time_us([&](){ Kernel::getKernel()->loadPlugin(options().plugin); });
+        std::printf("loadPlugin: %.3f us for %zu cells, %.3f us/cell\n",
+                load, count, load / count);
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_STARTUP_HPP_ */
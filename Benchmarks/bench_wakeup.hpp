@@ -0,0 +1,112 @@
+/*
+ * bench_wakeup.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCH_WAKEUP_HPP_
+#define BENCHMARKS_BENCH_WAKEUP_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/dataflow.h"
+#include "benchmark.hpp"
+#include "circuits.hpp"
+
+#include <atomic>
+#include <functional>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+/**
+ * Impl with every call to its process() counted, whatever it returns and
+ * whether or not observers get notified afterwards.
+ */
+template<typename Impl>
+struct Counting: Impl
+{
+    ReturnCode process(const CellSockets &i, const CellSockets &o)
+    {
+        calls.fetch_add(1, std::memory_order_relaxed);
+        return Impl::process(i, o);
+    }
+    static std::atomic<std::uint64_t> calls;
+};
+
+template<typename Impl>
+std::atomic<std::uint64_t> Counting<Impl>::calls(0);
+
+/**
+ * A Delay of ms milliseconds feeding n-1 Pause(0) cells, either as a chain
+ * or all directly.
+ */
+inline circuit_graph_ptr slow_upstream(std::size_t n, int ms, bool chain)
+{
+    circuit_graph_ptr graph(new CircuitGraph);
+    CircuitGraph &b = *graph;
+    cell_ptr head = prototype<Counting<Delay>>();
+    head->inputs["milliseconds"] << ms;
+    cell_ptr proto = prototype<Counting<Pause>>();
+    proto->inputs["milliseconds"] << 0;
+    std::size_t source = b.insert(head);
+    std::size_t prev = source;
+    for(std::size_t k = 1; k < n; k++)
+    {
+        std::size_t next = b.insert(proto->clone());
+        b.connect(chain ? prev : source, "done", next, "link");
+        prev = next;
+    }
+    return graph;
+}
+
+/**
+ * Counts every process() entry, per pid, while a slow Delay holds up the
+ * rest of the circuit. The Delay re-arms itself by design; every Pause
+ * needs exactly one call per pid, so Pause calls above n-1 per pid are
+ * polls of cells whose upstream has not produced the pid yet.
+ */
+BENCHMARK(Wakeup, Slow_upstream)
+{
+    SilenceStdout quiet;
+    Table table({"shape", "cells", "pids", "executor", "delay calls/pid",
+                 "pause calls/pid", "polls/pid", "ms/pid"});
+    const int ms = 5;
+    const int pids = std::max(1, std::min(options().pids, 20));
+    auto run = [&](bool chain, std::size_t n, const char *executor, std::function<void()> execute)
+    {
+        Counting<Delay>::calls = 0;
+        Counting<Pause>::calls = 0;
+        double us = time_us(execute);
+        double delay = static_cast<double>(Counting<Delay>::calls.load()) / pids;
+        double pause = static_cast<double>(Counting<Pause>::calls.load()) / pids;
+        table << (chain ? "chain" : "fan") << n << static_cast<std::size_t>(pids)
+              << executor << delay << pause << pause - static_cast<double>(n - 1)
+              << us / pids / 1000.0;
+    };
+    for(bool chain: {true, false})
+    {
+        for(std::size_t n: {10, 100, 1000})
+        {
+            if(n > options().max_cells)
+            {
+                continue;
+            }
+            circuit_graph_ptr b = slow_upstream(n, ms, chain);
+            b->circuit()->configure_all();
+            Scheduler sched(b->circuit());
+            run(chain, n, "Scheduler", [&](){ sched.execute(pids); });
+
+            TesterCell::DataflowExecutor exec(*b);
+            run(chain, n, "Dataflow", [&](){ exec.execute(pids); });
+        }
+    }
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_BENCH_WAKEUP_HPP_ */
@@ -0,0 +1,271 @@
+/*
+ * benchmark.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_BENCHMARK_HPP_
+#define BENCHMARKS_BENCHMARK_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+  #include <unistd.h>
+#endif
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+typedef std::chrono::high_resolution_clock Clock;
+
+/**
+ * Options shared by every benchmark, filled in from the command line by
+ * Benchmarks/main.cpp.
+ */
+struct Options
+{
+    std::string filter;          //only run benchmarks whose name contains this
+    std::size_t max_cells = 100000; //largest circuit to build
+    int pids = 100;              //process ids per measurement
+    std::string plugin;          //plugin library Startup loads, none if empty
+};
+
+inline Options& options()
+{
+    static Options opts;
+    return opts;
+}
+
+/**
+ * Circuit sizes used by the scaling benchmarks, capped by --max-cells.
+ */
+inline std::vector<std::size_t> sizes()
+{
+    std::vector<std::size_t> all = {10, 100, 1000, 10000, 100000};
+    std::vector<std::size_t> out;
+    for(std::size_t n: all)
+    {
+        if(n <= options().max_cells)
+        {
+            out.push_back(n);
+        }
+    }
+    return out;
+}
+
+struct Case
+{
+    std::string name;
+    std::function<void()> run;
+};
+
+inline std::vector<Case>& cases()
+{
+    static std::vector<Case> all;
+    return all;
+}
+
+struct Registrar
+{
+    Registrar(const std::string &name, std::function<void()> fn)
+    {
+        cases().push_back(Case{name, fn});
+    }
+};
+
+/**
+ * Running statistics over a set of samples, in microseconds.
+ */
+class Samples
+{
+public:
+    void add(double us)
+    {
+        values_.push_back(us);
+    }
+    template<typename Duration>
+    void add(Duration d)
+    {
+        add(std::chrono::duration<double, std::micro>(d).count());
+    }
+    std::size_t size() const
+    {
+        return values_.size();
+    }
+    double total() const
+    {
+        double t = 0;
+        for(double v: values_) t += v;
+        return t;
+    }
+    double mean() const
+    {
+        return values_.empty() ? 0 : total() / values_.size();
+    }
+    double percentile(double p) const
+    {
+        if(values_.empty()) return 0;
+        std::vector<double> sorted(values_);
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t idx = static_cast<std::size_t>(p * (sorted.size() - 1) + 0.5);
+        return sorted[idx];
+    }
+private:
+    std::vector<double> values_;
+};
+
+/**
+ * Time a callable once and return the elapsed microseconds.
+ */
+template<typename F>
+double time_us(F &&f)
+{
+    auto t1 = Clock::now();
+    f();
+    auto t2 = Clock::now();
+    return std::chrono::duration<double, std::micro>(t2 - t1).count();
+}
+
+/**
+ * Number of calls to the global operator new so far, across the whole
+ * process including the engine. Counted by the replacement operators in
+ * Benchmarks/main.cpp.
+ */
+inline std::atomic<std::uint64_t>& allocations()
+{
+    static std::atomic<std::uint64_t> count(0);
+    return count;
+}
+
+/**
+ * Run a callable once and return the number of allocations it made.
+ */
+template<typename F>
+std::uint64_t count_allocations(F &&f)
+{
+    std::uint64_t before = allocations();
+    f();
+    return allocations() - before;
+}
+
+/**
+ * Resident set size of the process in bytes, 0 where it cannot be read.
+ */
+inline std::size_t rss_bytes()
+{
+#if defined(__linux__)
+    long pages = 0, resident = 0;
+    if(FILE *f = std::fopen("/proc/self/statm", "r"))
+    {
+        if(std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+        {
+            resident = 0;
+        }
+        std::fclose(f);
+    }
+    return static_cast<std::size_t>(resident) * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Discards everything written to std::cout while in scope, so cells such as
+ * Print do not turn a benchmark into a terminal benchmark.
+ */
+class SilenceStdout
+{
+public:
+    SilenceStdout(): old_(std::cout.rdbuf(&null_)){}
+    ~SilenceStdout()
+    {
+        std::cout.rdbuf(old_);
+    }
+private:
+    struct NullBuffer: public std::streambuf
+    {
+        int overflow(int c){ return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n){ return n; }
+    };
+    NullBuffer null_;
+    std::streambuf *old_;
+};
+
+/**
+ * Fixed-width table printed to stdout, one row per measurement.
+ */
+class Table
+{
+public:
+    explicit Table(const std::vector<std::string> &columns): columns_(columns)
+    {
+        for(const std::string &c: columns_)
+        {
+            std::printf("%16s", c.c_str());
+        }
+        std::printf("\n");
+    }
+    Table& operator<<(const std::string &s)
+    {
+        std::printf("%16s", s.c_str());
+        return next();
+    }
+    Table& operator<<(double d)
+    {
+        std::printf("%16.3f", d);
+        return next();
+    }
+    Table& operator<<(std::size_t n)
+    {
+        std::printf("%16zu", n);
+        return next();
+    }
+private:
+    Table& next()
+    {
+        if(++col_ == columns_.size())
+        {
+            std::printf("\n");
+            std::fflush(stdout);
+            col_ = 0;
+        }
+        return *this;
+    }
+    std::vector<std::string> columns_;
+    std::size_t col_ = 0;
+};
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#define QUANTUM_BENCHMARK_NAME_(group, name) bench_##group##_##name
+
+/**
+ * Declares a benchmark the same way gtest's TEST declares a test:
+ *
+ *     BENCHMARK(Scheduler, Linear_chain)
+ *     {
+ *         ...
+ *     }
+ */
+#define BENCHMARK(group, name) \
+    static void QUANTUM_BENCHMARK_NAME_(group, name)(); \
+    static ::Quantum::Benchmark::Registrar \
+        QUANTUM_BENCHMARK_NAME_(group, name##_registrar)( \
+            #group "." #name, &QUANTUM_BENCHMARK_NAME_(group, name)); \
+    static void QUANTUM_BENCHMARK_NAME_(group, name)()
+
+#endif /* BENCHMARKS_BENCHMARK_HPP_ */
@@ -0,0 +1,218 @@
+/*
+ * circuits.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef BENCHMARKS_CIRCUITS_HPP_
+#define BENCHMARKS_CIRCUITS_HPP_
+
+#include "Engine/all.hpp"
+#include "Tests/cells.hpp"
+#include "TesterCell/tester.h"
+#include "TesterCell/generator.h"
+#include "TesterCell/batch.h"
+
+#include <string>
+#include <vector>
+
+namespace Quantum
+{
+namespace Benchmark
+{
+
+using TesterCell::CircuitGraph;
+using TesterCell::circuit_graph_ptr;
+
+template<typename T>
+cell_ptr prototype()
+{
+    cell_ptr c = std::make_shared<Cell_<T>>();
+    c->declare_params();
+    c->declare_io();
+    return c;
+}
+
+enum ChainKind
+{
+    CHAIN_ADD,
+    CHAIN_OPERATION,
+    CHAIN_PAUSE,
+    CHAIN_CONTROL   //Start -> If -> Print -> If -> Print ...
+};
+
+inline const char* chain_name(ChainKind kind)
+{
+    switch(kind)
+    {
+    case CHAIN_ADD: return "Add";
+    case CHAIN_OPERATION: return "Operation";
+    case CHAIN_PAUSE: return "Pause";
+    case CHAIN_CONTROL: return "If/Print";
+    }
+    return "";
+}
+
+/**
+ * n cells, each feeding the next.
+ */
+inline circuit_graph_ptr linear_chain(ChainKind kind, std::size_t n)
+{
+    circuit_graph_ptr graph(new CircuitGraph);
+    CircuitGraph &b = *graph;
+    switch(kind)
+    {
+    case CHAIN_ADD:
+    {
+        cell_ptr proto = prototype<Add>();
+        proto->inputs["left"] << 1.0;
+        proto->inputs["right"] << 1.0;
+        std::size_t prev = b.insert(proto->clone());
+        for(std::size_t k = 1; k < n; k++)
+        {
+            std::size_t next = b.insert(proto->clone());
+            b.connect(prev, "out", next, "left");
+            prev = next;
+        }
+        break;
+    }
+    case CHAIN_OPERATION:
+    {
+        cell_ptr proto = prototype<Operation>();
+        proto->inputs["a"] << 1;
+        proto->inputs["b"] << 1;
+        std::size_t prev = b.insert(proto->clone());
+        for(std::size_t k = 1; k < n; k++)
+        {
+            std::size_t next = b.insert(proto->clone());
+            b.connect(prev, "ans", next, "a");
+            prev = next;
+        }
+        break;
+    }
+    case CHAIN_PAUSE:
+    {
+        cell_ptr proto = prototype<Pause>();
+        proto->inputs["milliseconds"] << 0;
+        std::size_t prev = b.insert(proto->clone());
+        for(std::size_t k = 1; k < n; k++)
+        {
+            std::size_t next = b.insert(proto->clone());
+            b.connect(prev, "done", next, "link");
+            prev = next;
+        }
+        break;
+    }
+    case CHAIN_CONTROL:
+    {
+        cell_ptr if_proto = prototype<TesterCell::If>();
+        if_proto->inputs["condition"] << true;
+        cell_ptr print_proto = prototype<TesterCell::Print>();
+        std::size_t prev = b.insert(prototype<TesterCell::Start>());
+        std::string out = ">>";
+        for(std::size_t k = 1; k < n; k++)
+        {
+            bool is_if = (k % 2 == 1);
+            std::size_t next = b.insert(is_if ? if_proto->clone() : print_proto->clone());
+            b.connect(prev, out, next, ">>");
+            out = is_if ? "true >>" : ">>";
+            prev = next;
+        }
+        break;
+    }
+    }
+    return graph;
+}
+
+/**
+ * One Add cell feeding n-1 consumers.
+ */
+inline circuit_graph_ptr fan_out(std::size_t n)
+{
+    circuit_graph_ptr graph(new CircuitGraph);
+    CircuitGraph &b = *graph;
+    cell_ptr proto = prototype<Add>();
+    proto->inputs["left"] << 1.0;
+    proto->inputs["right"] << 1.0;
+    std::size_t source = b.insert(proto->clone());
+    for(std::size_t k = 1; k < n; k++)
+    {
+        std::size_t sink = b.insert(proto->clone());
+        b.connect(source, "out", sink, "left");
+    }
+    return graph;
+}
+
+/**
+ * One BatchMultiplyAdd feeding n-1 BatchMultiplyAdd consumers, every batch
+ * holding width doubles, so each cell does real work.
+ */
+inline circuit_graph_ptr batch_fan_out(std::size_t n, std::size_t width)
+{
+    circuit_graph_ptr graph(new CircuitGraph);
+    CircuitGraph &b = *graph;
+    cell_ptr proto = prototype<TesterCell::BatchMultiplyAdd>();
+    TesterCell::Batch ones(width, 1.0);
+    proto->inputs["a"] << ones;
+    proto->inputs["b"] << ones;
+    proto->inputs["c"] << ones;
+    std::size_t source = b.insert(proto->clone());
+    for(std::size_t k = 1; k < n; k++)
+    {
+        std::size_t sink = b.insert(proto->clone());
+        b.connect(source, "out", sink, "a");
+    }
+    return graph;
+}
+
+/**
+ * Stacked diamonds of Add cells:
+ *
+ *        /-l-\
+ *   top -     - bottom (= next top) ...
+ *        \-r-/
+ */
+inline circuit_graph_ptr diamonds(std::size_t n)
+{
+    circuit_graph_ptr graph(new CircuitGraph);
+    CircuitGraph &b = *graph;
+    cell_ptr proto = prototype<Add>();
+    proto->inputs["left"] << 1.0;
+    proto->inputs["right"] << 1.0;
+    std::size_t top = b.insert(proto->clone());
+    while(b.size() + 3 <= n)
+    {
+        std::size_t l = b.insert(proto->clone());
+        std::size_t r = b.insert(proto->clone());
+        std::size_t bottom = b.insert(proto->clone());
+        b.connect(top, "out", l, "left");
+        b.connect(top, "out", r, "left");
+        b.connect(l, "out", bottom, "left");
+        b.connect(r, "out", bottom, "right");
+        top = bottom;
+    }
+    return graph;
+}
+
+/**
+ * n Add/Operation cells wired at random by the plugin's CircuitGenerator.
+ */
+inline circuit_graph_ptr random_dag(std::size_t n, unsigned seed)
+{
+    TesterCell::GeneratorOptions opts;
+    opts.seed = seed;
+    opts.cells = n;
+    opts.fan_in = 1.0;
+    opts.max_fan_out = 4;
+    opts.mix.pause = 0;
+    opts.mix.branch = 0;
+    opts.mix.print = 0;
+    return TesterCell::CircuitGenerator(opts).generate();
+}
+
+}//namespace Benchmark
+}//namespace Quantum
+
+#endif /* BENCHMARKS_CIRCUITS_HPP_ */
@@ -0,0 +1,94 @@
+/*
+ * main.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * Usage: TesterCellBenchmarks [--filter=Scheduler.] [--max-cells=100000]
+ *                             [--pids=100] [--plugin=path/to/plugin]
+ */
+
+#include "Benchmarks/all.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+void* operator new(std::size_t size)
+{
+    Quantum::Benchmark::allocations().fetch_add(1, std::memory_order_relaxed);
+    if(void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+int main(int argc, char **argv)
+{
+    using namespace Quantum::Benchmark;
+    Options &opts = options();
+    for(int k = 1; k < argc; k++)
+    {
+        const char *arg = argv[k];
+        if(std::strncmp(arg, "--filter=", 9) == 0)
+        {
+            opts.filter = arg + 9;
+        }
+        else if(std::strncmp(arg, "--max-cells=", 12) == 0)
+        {
+            opts.max_cells = std::strtoul(arg + 12, nullptr, 10);
+        }
+        else if(std::strncmp(arg, "--pids=", 7) == 0)
+        {
+            opts.pids = std::max(1, std::atoi(arg + 7));
+        }
+        else if(std::strncmp(arg, "--plugin=", 9) == 0)
+        {
+            opts.plugin = arg + 9;
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown argument %s\n", arg);
+            return 1;
+        }
+    }
+
+    for(const Case &c: cases())
+    {
+        if(c.name.find(opts.filter) == std::string::npos)
+        {
+            continue;
+        }
+        std::printf("[ BENCHMARK ] %s\n", c.name.c_str());
+        c.run();
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * arena.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+namespace Quantum {
+namespace TesterCell {
+
+CellArena::CellArena(std::size_t chunk_bytes):
+        chunk_bytes_(chunk_bytes)
+{
+    if(chunk_bytes_ == 0)
+    {
+        throw std::runtime_error("CellArena needs a chunk size above zero");
+    }
+}
+
+CellArena::~CellArena()
+{
+    for(char *c: chunks_)
+    {
+        delete[] c;
+    }
+}
+
+void* CellArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    std::uintptr_t p = reinterpret_cast<std::uintptr_t>(next_);
+    std::uintptr_t aligned = (p + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    if(!next_ || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_))
+    {
+        //new[] memory is aligned for any fundamental type
+        std::size_t size = std::max(chunk_bytes_, bytes + alignment);
+        chunks_.push_back(new char[size]);
+        next_ = chunks_.back();
+        end_ = next_ + size;
+        reserved_ += size;
+        p = reinterpret_cast<std::uintptr_t>(next_);
+        aligned = (p + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+    }
+    next_ = reinterpret_cast<char*>(aligned + bytes);
+    used_ += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void copy_values(const cell_ptr &cell, const cell_ptr &prototype)
+{
+    for(const auto &p: prototype->parameters)
+    {
+        cell->parameters[p.first] << p.second;
+    }
+    for(const auto &i: prototype->inputs)
+    {
+        cell->inputs[i.first] << i.second;
+    }
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,105 @@
+/*
+ * arena.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_ARENA_H_
+#define TESTERCELL_ARENA_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Monotonic memory for the cells of one circuit. Allocation bumps a
+ * pointer through large chunks and deallocation does nothing, the chunks
+ * are freed all at once with the arena.
+ *
+ * Allocate from one thread at a time, as a circuit is built.
+ */
+class TESTERCELL_API CellArena
+{
+public:
+    explicit CellArena(std::size_t chunk_bytes = 1 << 20);
+    ~CellArena();
+    CellArena(const CellArena&) = delete;
+    CellArena& operator=(const CellArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment);
+    /** Bytes handed out so far. */
+    std::size_t used() const {return used_;}
+    /** Bytes held in chunks. */
+    std::size_t reserved() const {return reserved_;}
+private:
+    std::size_t chunk_bytes_;
+    std::vector<char*> chunks_;
+    char *next_ = nullptr;
+    char *end_ = nullptr;
+    std::size_t used_ = 0, reserved_ = 0;
+};
+
+typedef std::shared_ptr<CellArena> arena_ptr;
+
+/**
+ * Standard allocator over a CellArena. It holds a reference to the arena,
+ * so objects made with std::allocate_shared keep their arena alive and the
+ * arena is freed when the last of them is destroyed.
+ */
+template<typename T>
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(arena_ptr arena): arena_(std::move(arena)) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other): arena_(other.arena()) {}
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, std::size_t) {}
+
+    const arena_ptr& arena() const {return arena_;}
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {return arena_ == other.arena();}
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {return arena_ != other.arena();}
+private:
+    arena_ptr arena_;
+};
+
+/**
+ * Like std::make_shared<Cell_<T>>() followed by declare_params() and
+ * declare_io(), with the cell and its control block in arena. The sockets
+ * a cell declares are allocated by the engine and stay on the heap.
+ */
+template<typename T>
+cell_ptr make_cell(const arena_ptr &arena)
+{
+    cell_ptr c = std::allocate_shared<Cell_<T>>(ArenaAllocator<Cell_<T>>(arena));
+    c->declare_params();
+    c->declare_io();
+    return c;
+}
+
+/**
+ * Gives cell the parameter and input values of prototype, a cell of the
+ * same type, as clone() does.
+ */
+TESTERCELL_API void copy_values(const cell_ptr &cell, const cell_ptr &prototype);
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_ARENA_H_ */
@@ -0,0 +1,200 @@
+/*
+ * async_writer.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/async_writer.h"
+
+#include <cerrno>
+
+#if defined(TESTERCELLPLUGIN_WIN32)
+  #include <io.h>
+  #define TESTERCELL_WRITE _write
+#else
+  #include <unistd.h>
+  #define TESTERCELL_WRITE ::write
+#endif
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+std::size_t round_up_pow2(std::size_t n)
+{
+    std::size_t p = 2;
+    while(p < n)
+    {
+        p <<= 1;
+    }
+    return p;
+}
+
+//the writer thread would spin on a zero wait
+long long clamp_interval(std::chrono::milliseconds interval)
+{
+    return interval.count() < 1 ? 1 : interval.count();
+}
+
+void write_all(int fd, const char *data, std::size_t size)
+{
+    while(size > 0)
+    {
+        auto n = TESTERCELL_WRITE(fd, data, static_cast<unsigned>(size));
+        if(n < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return; //nowhere left to report a failing log stream
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+}//namespace
+
+AsyncWriter::AsyncWriter(int fd, std::size_t capacity, std::size_t max_bytes,
+        std::chrono::milliseconds flush_interval):
+        fd_(fd),
+        mask_(round_up_pow2(capacity) - 1),
+        max_bytes_(max_bytes),
+        slots_(new Slot[mask_ + 1]),
+        tail_(0),
+        head_(0),
+        pending_bytes_(0),
+        written_(0),
+        dropped_(0),
+        writes_(0),
+        interval_ms_(clamp_interval(flush_interval)),
+        stop_(false)
+{
+    for(std::size_t k = 0; k <= mask_; k++)
+    {
+        slots_[k].sequence.store(k, std::memory_order_relaxed);
+    }
+    thread_ = std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    drain();
+}
+
+bool AsyncWriter::write(std::string msg)
+{
+    std::size_t bytes = msg.size();
+    if(pending_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes > max_bytes_)
+    {
+        pending_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        dropped_++;
+        return false;
+    }
+
+    //bounded multi-producer ring (Vyukov): a slot is free for position pos
+    //when its sequence equals pos, and holds a message when it equals pos+1
+    std::size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot;
+    for(;;)
+    {
+        slot = &slots_[pos & mask_];
+        std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if(diff == 0)
+        {
+            if(tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            pending_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+            dropped_++;
+            return false;
+        }
+        else
+        {
+            pos = tail_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->msg = std::move(msg);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncWriter::flush()
+{
+    drain();
+}
+
+void AsyncWriter::flush_interval(std::chrono::milliseconds interval)
+{
+    interval_ms_ = clamp_interval(interval);
+    wake_.notify_one();
+}
+
+std::chrono::milliseconds AsyncWriter::flush_interval() const
+{
+    return std::chrono::milliseconds(interval_ms_.load());
+}
+
+void AsyncWriter::run()
+{
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    while(!stop_)
+    {
+        wake_.wait_for(lock, flush_interval());
+        lock.unlock();
+        drain();
+        lock.lock();
+    }
+}
+
+void AsyncWriter::drain()
+{
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    std::string batch;
+    std::uint64_t messages = 0;
+    for(;;)
+    {
+        Slot &slot = slots_[head_ & mask_];
+        if(slot.sequence.load(std::memory_order_acquire) != head_ + 1)
+        {
+            break;
+        }
+        batch += slot.msg;
+        pending_bytes_.fetch_sub(slot.msg.size(), std::memory_order_relaxed);
+        //producers move their message in, a kept buffer would never be reused
+        std::string().swap(slot.msg);
+        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+        head_++;
+        messages++;
+    }
+    if(!batch.empty())
+    {
+        write_all(fd_, batch.data(), batch.size());
+        writes_++;
+    }
+    written_ += messages;
+}
+
+AsyncWriter& AsyncWriter::standard_output()
+{
+    static AsyncWriter writer(1);
+    return writer;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
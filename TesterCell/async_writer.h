@@ -0,0 +1,92 @@
+/*
+ * async_writer.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_ASYNC_WRITER_H_
+#define TESTERCELL_ASYNC_WRITER_H_
+
+#include "testercell_config.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Writes messages to a file descriptor from a background thread.
+ *
+ * write() never blocks and never takes a lock: messages go into a bounded
+ * lock-free ring buffer and a writer thread drains it every flush interval,
+ * joining whatever is queued into a single write(2). When the ring or the
+ * byte budget is full the message is dropped and counted instead.
+ */
+class TESTERCELL_API AsyncWriter
+{
+public:
+    AsyncWriter(int fd, std::size_t capacity = 4096,
+            std::size_t max_bytes = 1 << 20,
+            std::chrono::milliseconds flush_interval = std::chrono::milliseconds(10));
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    /** Queues msg, returns false if it had to be dropped. */
+    bool write(std::string msg);
+    /** Writes out everything queued so far from the calling thread. */
+    void flush();
+
+    /** Intervals shorter than a millisecond are raised to one. */
+    void flush_interval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds flush_interval() const;
+
+    std::uint64_t written() const {return written_;}
+    std::uint64_t dropped() const {return dropped_;}
+    std::uint64_t writes() const {return writes_;}
+
+    /**
+     * The process wide writer for standard output, used by buffered Print
+     * cells. Its flush interval is a process wide setting as well.
+     */
+    static AsyncWriter& standard_output();
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        std::string msg;
+    };
+
+    void run();
+    void drain();
+
+    int fd_;
+    std::size_t mask_;
+    std::size_t max_bytes_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<std::size_t> tail_;
+    std::size_t head_;
+    std::atomic<std::size_t> pending_bytes_;
+    std::atomic<std::uint64_t> written_, dropped_, writes_;
+    std::atomic<long long> interval_ms_;
+
+    std::mutex drain_mutex_; //serializes the consumer side only
+    std::mutex wait_mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+    std::thread thread_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_ASYNC_WRITER_H_ */
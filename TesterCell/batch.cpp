@@ -0,0 +1,201 @@
+/*
+ * batch.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/batch.h"
+#include "TesterCell/format.h"
+
+#include <stdexcept>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define TESTERCELL_SSE2 1
+#endif
+
+namespace Quantum {
+namespace TesterCell {
+namespace kernels {
+
+void add(const double *a, const double *b, double *out, std::size_t n)
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    for(; k + 4 <= n; k += 4)
+    {
+        _mm256_storeu_pd(out + k,
+                _mm256_add_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+    }
+#elif defined(TESTERCELL_SSE2)
+    for(; k + 2 <= n; k += 2)
+    {
+        _mm_storeu_pd(out + k, _mm_add_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k)));
+    }
+#endif
+    for(; k < n; k++)
+    {
+        out[k] = a[k] + b[k];
+    }
+}
+
+void subtract(const double *a, const double *b, double *out, std::size_t n)
+{
+    std::size_t k = 0;
+#if defined(__AVX2__)
+    for(; k + 4 <= n; k += 4)
+    {
+        _mm256_storeu_pd(out + k,
+                _mm256_sub_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k)));
+    }
+#elif defined(TESTERCELL_SSE2)
+    for(; k + 2 <= n; k += 2)
+    {
+        _mm_storeu_pd(out + k, _mm_sub_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k)));
+    }
+#endif
+    for(; k < n; k++)
+    {
+        out[k] = a[k] - b[k];
+    }
+}
+
+void multiply_add(const double *a, const double *b, const double *c,
+        double *out, std::size_t n)
+{
+    std::size_t k = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+    for(; k + 4 <= n; k += 4)
+    {
+        _mm256_storeu_pd(out + k, _mm256_fmadd_pd(_mm256_loadu_pd(a + k),
+                _mm256_loadu_pd(b + k), _mm256_loadu_pd(c + k)));
+    }
+#elif defined(__AVX2__)
+    for(; k + 4 <= n; k += 4)
+    {
+        __m256d ab = _mm256_mul_pd(_mm256_loadu_pd(a + k), _mm256_loadu_pd(b + k));
+        _mm256_storeu_pd(out + k, _mm256_add_pd(ab, _mm256_loadu_pd(c + k)));
+    }
+#elif defined(TESTERCELL_SSE2)
+    for(; k + 2 <= n; k += 2)
+    {
+        __m128d ab = _mm_mul_pd(_mm_loadu_pd(a + k), _mm_loadu_pd(b + k));
+        _mm_storeu_pd(out + k, _mm_add_pd(ab, _mm_loadu_pd(c + k)));
+    }
+#endif
+    for(; k < n; k++)
+    {
+        out[k] = a[k] * b[k] + c[k];
+    }
+}
+
+const char* isa()
+{
+#if defined(__AVX2__) && defined(__FMA__)
+    return "avx2+fma";
+#elif defined(__AVX2__)
+    return "avx2";
+#elif defined(TESTERCELL_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+}//namespace kernels
+
+namespace {
+
+void check_sizes(const Batch &a, const Batch &b)
+{
+    if(a.size() != b.size())
+    {
+        throw std::runtime_error("Batch sizes differ: " + std::to_string(a.size())
+                + " and " + std::to_string(b.size()));
+    }
+}
+
+}//namespace
+
+void BatchAdd::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
+{
+    i.declare(&BatchAdd::left_, "left");
+    lazy_str<Batch>(i, "left");
+    i.declare(&BatchAdd::right_, "right");
+    lazy_str<Batch>(i, "right");
+    o.declare(&BatchAdd::out_, "out");
+    lazy_str<Batch>(o, "out");
+}
+
+ReturnCode BatchAdd::process(const CellSockets &i, const CellSockets &o)
+{
+    check_sizes(*left_, *right_);
+    out_->resize(left_->size());
+    kernels::add(left_->data(), right_->data(), out_->data(), out_->size());
+    return Quantum::OK;
+}
+
+void BatchOperation::declare_params(CellSockets &p)
+{
+    p.declare<bool>("minus", "Subtraction", false);
+}
+
+void BatchOperation::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
+{
+    i.declare(&BatchOperation::a_, "a");
+    lazy_str<Batch>(i, "a");
+    i.declare(&BatchOperation::b_, "b");
+    lazy_str<Batch>(i, "b");
+    o.declare(&BatchOperation::ans_, "ans");
+    lazy_str<Batch>(o, "ans");
+}
+
+void BatchOperation::configure(const CellSockets &p, const CellSockets &i,
+        const CellSockets &o)
+{
+    minus_ = p.get<bool>("minus");
+}
+
+ReturnCode BatchOperation::process(const CellSockets &i, const CellSockets &o)
+{
+    check_sizes(*a_, *b_);
+    ans_->resize(a_->size());
+    if(minus_)
+    {
+        kernels::subtract(a_->data(), b_->data(), ans_->data(), ans_->size());
+    }
+    else
+    {
+        kernels::add(a_->data(), b_->data(), ans_->data(), ans_->size());
+    }
+    return Quantum::OK;
+}
+
+void BatchMultiplyAdd::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
+{
+    i.declare(&BatchMultiplyAdd::a_, "a");
+    lazy_str<Batch>(i, "a");
+    i.declare(&BatchMultiplyAdd::b_, "b");
+    lazy_str<Batch>(i, "b");
+    i.declare(&BatchMultiplyAdd::c_, "c");
+    lazy_str<Batch>(i, "c");
+    o.declare(&BatchMultiplyAdd::out_, "out");
+    lazy_str<Batch>(o, "out");
+}
+
+ReturnCode BatchMultiplyAdd::process(const CellSockets &i, const CellSockets &o)
+{
+    check_sizes(*a_, *b_);
+    check_sizes(*a_, *c_);
+    out_->resize(a_->size());
+    kernels::multiply_add(a_->data(), b_->data(), c_->data(), out_->data(),
+            out_->size());
+    return Quantum::OK;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,79 @@
+/*
+ * batch.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_BATCH_H_
+#define TESTERCELL_BATCH_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Element-wise kernels used by the batch cells. They use AVX2 (and FMA) or
+ * SSE2 when the plugin is compiled for it and fall back to plain loops
+ * otherwise. out may alias any of the inputs.
+ */
+namespace kernels {
+TESTERCELL_API void add(const double *a, const double *b, double *out, std::size_t n);
+TESTERCELL_API void subtract(const double *a, const double *b, double *out, std::size_t n);
+TESTERCELL_API void multiply_add(const double *a, const double *b, const double *c,
+        double *out, std::size_t n);
+/** Name of the instruction set the kernels were compiled for. */
+TESTERCELL_API const char* isa();
+}//namespace kernels
+
+typedef std::vector<double> Batch;
+
+/**
+ * Batch version of Add: out[k] = left[k] + right[k].
+ */
+class TESTERCELL_API BatchAdd
+{
+public:
+    static void declare_params(CellSockets &p){}
+    static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
+    ReturnCode process(const CellSockets&, const CellSockets&);
+    SocketHandle<Batch> left_, right_, out_;
+};
+
+/**
+ * Batch version of Operation: ans[k] = a[k] + b[k], or a[k] - b[k] when the
+ * "minus" parameter is set.
+ */
+class TESTERCELL_API BatchOperation
+{
+public:
+    static void declare_params(CellSockets &p);
+    static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
+    void configure(const CellSockets&, const CellSockets&, const CellSockets&);
+    ReturnCode process(const CellSockets&, const CellSockets&);
+    SocketHandle<Batch> a_, b_, ans_;
+private:
+    bool minus_ = false;
+};
+
+/**
+ * Fused multiply-add over batches: out[k] = a[k] * b[k] + c[k].
+ */
+class TESTERCELL_API BatchMultiplyAdd
+{
+public:
+    static void declare_params(CellSockets &p){}
+    static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
+    ReturnCode process(const CellSockets&, const CellSockets&);
+    SocketHandle<Batch> a_, b_, c_, out_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_BATCH_H_ */
@@ -0,0 +1,158 @@
+/*
+ * circuit_graph.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/circuit_graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Quantum {
+namespace TesterCell {
+
+CircuitGraph::CircuitGraph():circuit_(new Circuit)
+{}
+
+CircuitGraph::CircuitGraph(const circuit_ptr &circuit):circuit_(circuit)
+{}
+
+std::size_t CircuitGraph::insert(const cell_ptr &cell)
+{
+    if(index_.count(cell.get()))
+    {
+        throw std::runtime_error("Cell is already part of this circuit graph");
+    }
+    circuit_->insert(cell);
+    std::size_t k = cells_.size();
+    cells_.push_back(cell);
+    index_[cell.get()] = k;
+    record(CircuitEdit{CircuitEdit::INSERT, k, Connection()});
+    return k;
+}
+
+void CircuitGraph::connect(std::size_t from, const std::string &output,
+        std::size_t to, const std::string &input)
+{
+    if(!contains(from) || !contains(to))
+    {
+        throw std::runtime_error("Cell is not part of this circuit graph");
+    }
+    circuit_->connect(cells_[from], output, cells_[to], input);
+    connections_.push_back(Connection{from, output, to, input});
+    record(CircuitEdit{CircuitEdit::CONNECT, 0, connections_.back()});
+}
+
+void CircuitGraph::connect(const cell_ptr &from, const std::string &output,
+        const cell_ptr &to, const std::string &input)
+{
+    connect(index(from), output, index(to), input);
+}
+
+void CircuitGraph::disconnect(std::size_t from, const std::string &output,
+        std::size_t to, const std::string &input)
+{
+    auto it = std::find_if(connections_.begin(), connections_.end(),
+            [&](const Connection &c)
+            {
+                return c.from == from && c.to == to && c.output == output && c.input == input;
+            });
+    if(it == connections_.end())
+    {
+        throw std::runtime_error("No such connection in this circuit graph");
+    }
+    circuit_->disconnect(cells_[from], output, cells_[to], input);
+    Connection c = *it;
+    connections_.erase(it);
+    record(CircuitEdit{CircuitEdit::DISCONNECT, 0, c});
+}
+
+void CircuitGraph::remove(std::size_t k)
+{
+    if(!contains(k))
+    {
+        throw std::runtime_error("Cell is not part of this circuit graph");
+    }
+    circuit_->remove(cells_[k]);
+    connections_.erase(std::remove_if(connections_.begin(), connections_.end(),
+            [k](const Connection &c){return c.from == k || c.to == k;}),
+            connections_.end());
+    index_.erase(cells_[k].get());
+    cells_[k].reset();
+    record(CircuitEdit{CircuitEdit::REMOVE, k, Connection()});
+}
+
+std::size_t CircuitGraph::follow() const
+{
+    if(followers_.empty())
+    {
+        journal_start_ = revision_;
+    }
+    followers_.insert(revision_);
+    return revision_;
+}
+
+std::size_t CircuitGraph::catch_up(std::size_t revision) const
+{
+    auto it = followers_.find(revision);
+    if(it == followers_.end())
+    {
+        throw std::runtime_error("Not a follower of this circuit graph");
+    }
+    followers_.erase(it);
+    followers_.insert(revision_);
+    trim();
+    return revision_;
+}
+
+void CircuitGraph::unfollow(std::size_t revision) const
+{
+    auto it = followers_.find(revision);
+    if(it != followers_.end())
+    {
+        followers_.erase(it);
+        trim();
+    }
+}
+
+std::vector<CircuitEdit> CircuitGraph::edits_since(std::size_t revision) const
+{
+    if(followers_.empty() || revision < journal_start_ || revision > revision_)
+    {
+        throw std::runtime_error("Circuit graph edits were not journaled");
+    }
+    return std::vector<CircuitEdit>(edits_.begin() + (revision - journal_start_),
+            edits_.end());
+}
+
+void CircuitGraph::record(const CircuitEdit &edit)
+{
+    revision_++;
+    if(!followers_.empty())
+    {
+        edits_.push_back(edit);
+    }
+}
+
+void CircuitGraph::trim() const
+{
+    std::size_t oldest = followers_.empty() ? revision_ : *followers_.begin();
+    edits_.erase(edits_.begin(), edits_.begin() + (oldest - journal_start_));
+    journal_start_ = oldest;
+}
+
+std::size_t CircuitGraph::index(const cell_ptr &cell) const
+{
+    auto it = index_.find(cell.get());
+    if(it == index_.end())
+    {
+        throw std::runtime_error("Cell is not part of this circuit graph");
+    }
+    return it->second;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,133 @@
+/*
+ * circuit_graph.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_CIRCUIT_GRAPH_H_
+#define TESTERCELL_CIRCUIT_GRAPH_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+struct Connection
+{
+    std::size_t from;
+    std::string output;
+    std::size_t to;
+    std::string input;
+};
+
+/**
+ * One change made to a CircuitGraph, as replayed by executors following it.
+ */
+struct CircuitEdit
+{
+    enum Kind
+    {
+        INSERT,
+        REMOVE,
+        CONNECT,
+        DISCONNECT
+    };
+    Kind kind;
+    std::size_t cell;       //INSERT, REMOVE
+    Connection connection;  //CONNECT, DISCONNECT
+};
+
+/**
+ * Builds a Circuit through the usual Circuit::insert/connect calls while
+ * keeping its cells and connections, in insertion order, for code that
+ * needs to walk the topology (benchmarks, generators, executors).
+ *
+ * Removed cells leave an empty slot so the indices of the other cells stay
+ * valid; cells() and operator[] return a null cell_ptr for them. While an
+ * executor follows the graph, every edit is also journaled so it can patch
+ * its state instead of being rebuilt. Edits every follower has caught up
+ * with are dropped from the journal.
+ *
+ * Followers keep a pointer to the graph, so it is neither copied nor moved;
+ * code building graphs hands them out as a circuit_graph_ptr. A cell can be
+ * inserted once.
+ */
+class TESTERCELL_API CircuitGraph
+{
+public:
+    CircuitGraph();
+    explicit CircuitGraph(const circuit_ptr &circuit);
+    CircuitGraph(const CircuitGraph&) = delete;
+    CircuitGraph& operator=(const CircuitGraph&) = delete;
+
+    /** Throws if cell is already part of this graph. */
+    std::size_t insert(const cell_ptr &cell);
+    void connect(std::size_t from, const std::string &output,
+            std::size_t to, const std::string &input);
+    void connect(const cell_ptr &from, const std::string &output,
+            const cell_ptr &to, const std::string &input);
+    /** Throws if there is no such connection. */
+    void disconnect(std::size_t from, const std::string &output,
+            std::size_t to, const std::string &input);
+    /** Removes cell k and every connection to or from it. */
+    void remove(std::size_t k);
+    bool contains(std::size_t k) const {return k < cells_.size() && cells_[k];}
+
+    /** Index of a cell previously inserted, throws if unknown. */
+    std::size_t index(const cell_ptr &cell) const;
+
+    const circuit_ptr& circuit() const {return circuit_;}
+    const std::vector<cell_ptr>& cells() const {return cells_;}
+    const std::vector<Connection>& connections() const {return connections_;}
+    const cell_ptr& operator[](std::size_t k) const {return cells_[k];}
+    std::size_t size() const {return cells_.size();}
+
+    /** Number of edits made since construction. */
+    std::size_t revision() const {return revision_;}
+    /**
+     * Registers a follower at revision(), which it returns, and journals
+     * edits until the follower is gone. Pair with unfollow().
+     */
+    std::size_t follow() const;
+    /** Moves a follower from revision to revision(), which it returns. */
+    std::size_t catch_up(std::size_t revision) const;
+    /** Unregisters a follower last caught up at revision. */
+    void unfollow(std::size_t revision) const;
+    /** Number of edits kept in the journal. */
+    std::size_t journaled() const {return edits_.size();}
+    /**
+     * Edits made since the given revision, which must be that of a
+     * registered follower.
+     */
+    std::vector<CircuitEdit> edits_since(std::size_t revision) const;
+private:
+    void record(const CircuitEdit &edit);
+    /** Drops the edits every follower has seen. */
+    void trim() const;
+
+    circuit_ptr circuit_;
+    std::vector<cell_ptr> cells_;
+    std::vector<Connection> connections_;
+    std::unordered_map<const Cell*, std::size_t> index_;
+    std::size_t revision_ = 0;
+    mutable std::multiset<std::size_t> followers_; //their revisions
+    mutable std::size_t journal_start_ = 0;
+    mutable std::deque<CircuitEdit> edits_;
+};
+
+typedef std::shared_ptr<CircuitGraph> circuit_graph_ptr;
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_CIRCUIT_GRAPH_H_ */
@@ -0,0 +1,351 @@
+/*
+ * dataflow.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/dataflow.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+Dataflow::Link make_link(std::size_t from_cell, const cellsocket_ptr &from,
+        const cellsocket_ptr &to)
+{
+    Dataflow::Link l{from_cell, from, to};
+    if(to->same_type(*from))
+    {
+        l.copy = inline_copy_for(*from);
+    }
+    return l;
+}
+
+}//namespace
+
+Dataflow::Dataflow(const CircuitGraph &graph, bool follow):
+        cells_(graph.cells()),
+        links_(graph.size()),
+        dependents_(graph.size()),
+        upstream_(graph.size(), 0),
+        live_(0),
+        followed_(follow ? &graph : nullptr),
+        revision_(follow ? graph.follow() : graph.revision())
+{
+    for(const cell_ptr &c: cells_)
+    {
+        live_ += c ? 1 : 0;
+    }
+    for(const Connection &c: graph.connections())
+    {
+        links_[c.to].push_back(make_link(c.from, cells_[c.from]->outputs[c.output],
+                cells_[c.to]->inputs[c.input]));
+        dependents_[c.from].push_back(c.to);
+    }
+    for(std::size_t k = 0; k < cells_.size(); k++)
+    {
+        std::vector<std::size_t> &d = dependents_[k];
+        std::sort(d.begin(), d.end());
+        d.erase(std::unique(d.begin(), d.end()), d.end());
+        for(std::size_t down: d)
+        {
+            upstream_[down]++;
+        }
+    }
+}
+
+Dataflow::~Dataflow()
+{
+    if(followed_)
+    {
+        followed_->unfollow(revision_);
+    }
+}
+
+void Dataflow::pull(std::size_t k) const
+{
+    for(const Link &l: links_[k])
+    {
+        if(l.mover)
+        {
+            l.mover(*l.to, *l.from);
+        }
+        else if(l.copy)
+        {
+            l.copy(*l.to, *l.from);
+        }
+        else
+        {
+            l.to << l.from;
+        }
+    }
+}
+
+void Dataflow::move_single_consumer(bool on)
+{
+    move_ = on;
+    resolve_movers();
+}
+
+void Dataflow::resolve_movers()
+{
+    std::unordered_map<const CellSocket*, std::size_t> consumers;
+    if(move_)
+    {
+        for(const std::vector<Link> &in: links_)
+        {
+            for(const Link &l: in)
+            {
+                consumers[l.from.get()]++;
+            }
+        }
+    }
+    for(std::vector<Link> &in: links_)
+    {
+        for(Link &l: in)
+        {
+            l.mover = nullptr;
+            if(move_ && consumers[l.from.get()] == 1 && l.to->same_type(*l.from) &&
+                    is_move_source(*cells_[l.from_cell]))
+            {
+                l.mover = mover_for(*l.from);
+            }
+        }
+    }
+}
+
+std::vector<std::size_t> Dataflow::topological_order() const
+{
+    std::vector<std::size_t> pending(upstream_);
+    std::vector<std::size_t> order;
+    order.reserve(live_);
+    for(std::size_t k = 0; k < cells_.size(); k++)
+    {
+        if(cells_[k] && !pending[k])
+        {
+            order.push_back(k);
+        }
+    }
+    for(std::size_t next = 0; next < order.size(); next++)
+    {
+        for(std::size_t down: dependents_[order[next]])
+        {
+            if(--pending[down] == 0)
+            {
+                order.push_back(down);
+            }
+        }
+    }
+    if(order.size() != live_)
+    {
+        throw std::runtime_error("Circuit graph has a cycle");
+    }
+    return order;
+}
+
+bool Dataflow::sync(const CircuitGraph &graph)
+{
+    if(&graph != followed_)
+    {
+        throw std::runtime_error("Dataflow does not follow this circuit graph");
+    }
+    if(graph.revision() == revision_)
+    {
+        return false;
+    }
+    for(const CircuitEdit &e: graph.edits_since(revision_))
+    {
+        switch(e.kind)
+        {
+        case CircuitEdit::INSERT:
+            insert(e.cell, graph.cells()[e.cell]);
+            break;
+        case CircuitEdit::REMOVE:
+            remove(e.cell);
+            break;
+        case CircuitEdit::CONNECT:
+            connect(e.connection);
+            break;
+        case CircuitEdit::DISCONNECT:
+            disconnect(e.connection);
+            break;
+        }
+    }
+    revision_ = graph.catch_up(revision_);
+    if(move_)
+    {
+        resolve_movers();
+    }
+    return true;
+}
+
+void Dataflow::insert(std::size_t k, const cell_ptr &cell)
+{
+    if(k >= cells_.size())
+    {
+        cells_.resize(k + 1);
+        links_.resize(k + 1);
+        dependents_.resize(k + 1);
+        upstream_.resize(k + 1, 0);
+    }
+    //null when the cell was removed again by a later edit
+    if(cell)
+    {
+        //the rest of the circuit was configured before it started running
+        cell->configure();
+        cells_[k] = cell;
+        live_++;
+    }
+}
+
+void Dataflow::remove(std::size_t k)
+{
+    if(k >= cells_.size() || !cells_[k])
+    {
+        return;
+    }
+    for(const Link &l: links_[k])
+    {
+        std::vector<std::size_t> &d = dependents_[l.from_cell];
+        auto it = std::find(d.begin(), d.end(), k);
+        if(it != d.end())
+        {
+            d.erase(it);
+        }
+    }
+    links_[k].clear();
+    upstream_[k] = 0;
+    for(std::size_t down: dependents_[k])
+    {
+        std::vector<Link> &in = links_[down];
+        in.erase(std::remove_if(in.begin(), in.end(),
+                [k](const Link &l){return l.from_cell == k;}), in.end());
+        upstream_[down]--;
+    }
+    dependents_[k].clear();
+    cells_[k].reset();
+    live_--;
+}
+
+void Dataflow::connect(const Connection &c)
+{
+    if(!cells_[c.from] || !cells_[c.to])
+    {
+        return;
+    }
+    std::vector<Link> &in = links_[c.to];
+    bool linked = std::any_of(in.begin(), in.end(),
+            [&](const Link &l){return l.from_cell == c.from;});
+    in.push_back(make_link(c.from, cells_[c.from]->outputs[c.output],
+            cells_[c.to]->inputs[c.input]));
+    if(!linked)
+    {
+        dependents_[c.from].push_back(c.to);
+        upstream_[c.to]++;
+    }
+}
+
+void Dataflow::disconnect(const Connection &c)
+{
+    if(!cells_[c.from] || !cells_[c.to])
+    {
+        return;
+    }
+    cellsocket_ptr from = cells_[c.from]->outputs[c.output];
+    cellsocket_ptr to = cells_[c.to]->inputs[c.input];
+    std::vector<Link> &in = links_[c.to];
+    auto it = std::find_if(in.begin(), in.end(), [&](const Link &l)
+    {
+        return l.from_cell == c.from && l.from == from && l.to == to;
+    });
+    if(it == in.end())
+    {
+        return;
+    }
+    in.erase(it);
+    unlink(c.from, c.to);
+}
+
+void Dataflow::unlink(std::size_t from, std::size_t to)
+{
+    //another connection between the same two cells keeps the dependency
+    const std::vector<Link> &in = links_[to];
+    if(std::any_of(in.begin(), in.end(), [from](const Link &l){return l.from_cell == from;}))
+    {
+        return;
+    }
+    std::vector<std::size_t> &d = dependents_[from];
+    d.erase(std::find(d.begin(), d.end(), to));
+    upstream_[to]--;
+}
+
+DataflowExecutor::DataflowExecutor(const CircuitGraph &graph):
+        graph_(graph),
+        flow_(graph, true),
+        stall_timeout_(std::chrono::milliseconds::zero())
+{
+    graph.circuit()->configure_all();
+}
+
+ReturnCode DataflowExecutor::execute(int n)
+{
+    for(int pid = 0; pid < n; pid++)
+    {
+        if(between_pids_)
+        {
+            between_pids_(pid);
+        }
+        flow_.sync(graph_);
+        ReturnCode ret = execute_pid(pid);
+        if(ret != Quantum::OK)
+        {
+            return ret;
+        }
+    }
+    return Quantum::OK;
+}
+
+ReturnCode DataflowExecutor::execute_pid(int pid)
+{
+    pending_.resize(flow_.size());
+    ready_.clear();
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        pending_[k] = flow_.upstream(k);
+        if(!pending_[k] && flow_.cell(k))
+        {
+            ready_.push(k);
+        }
+    }
+    auto process = [&](std::size_t k, bool retry)
+    {
+        if(!retry)
+        {
+            flow_.pull(k);
+        }
+        ReturnCode ret = flow_.cell(k)->process(pid);
+        stats_.processed++;
+        return ret;
+    };
+    auto release = [&](std::size_t k)
+    {
+        for(std::size_t down: flow_.dependents(k))
+        {
+            if(--pending_[down] == 0)
+            {
+                ready_.push(down);
+            }
+        }
+    };
+    return ready_.run(process, release, stall_timeout_, stats_);
+}
+
+}//namespace TesterCell
+}//namespace Quantum
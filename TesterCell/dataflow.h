@@ -0,0 +1,281 @@
+/*
+ * dataflow.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_DATAFLOW_H_
+#define TESTERCELL_DATAFLOW_H_
+
+#include "TesterCell/circuit_graph.h"
+#include "TesterCell/move.h"
+#include "TesterCell/wakeup.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * The topology of a CircuitGraph resolved for execution: for every cell,
+ * the socket pairs feeding its inputs, the distinct cells downstream of it
+ * and the number of distinct cells upstream of it.
+ *
+ * Indices are those of the graph, slots of removed cells hold a null cell.
+ * A Dataflow constructed to follow its graph can sync(), which patches the
+ * topology with the edits made to the graph since the last sync, at a cost
+ * proportional to the edits rather than the circuit. The graph then keeps
+ * a journal of edits and must outlive the Dataflow.
+ */
+class TESTERCELL_API Dataflow
+{
+public:
+    struct Link
+    {
+        std::size_t from_cell;
+        cellsocket_ptr from, to;
+        SocketMover mover = nullptr; //set when the value is moved, not copied
+        SocketMover copy = nullptr;  //set when the value is copied inline
+    };
+
+    explicit Dataflow(const CircuitGraph &graph, bool follow = false);
+    ~Dataflow();
+    Dataflow(const Dataflow&) = delete;
+    Dataflow& operator=(const Dataflow&) = delete;
+
+    std::size_t size() const {return cells_.size();}
+    /** Number of cells that were not removed. */
+    std::size_t live() const {return live_;}
+    const cell_ptr& cell(std::size_t k) const {return cells_[k];}
+    const std::vector<std::size_t>& dependents(std::size_t k) const {return dependents_[k];}
+    std::size_t upstream(std::size_t k) const {return upstream_[k];}
+    /** The connections feeding the inputs of cell k. */
+    const std::vector<Link>& links(std::size_t k) const {return links_[k];}
+
+    /**
+     * Cell indices ordered so every cell comes after all of its upstream
+     * cells. Throws std::runtime_error if the circuit has a cycle.
+     */
+    std::vector<std::size_t> topological_order() const;
+
+    /**
+     * Copy value and token id into every connected input of cell k from
+     * the output feeding it, as operator<< between sockets does. Small
+     * values with an inline copy (see copy_inline) are assigned in place.
+     * With movers set, call it once per pid and not again for a retry.
+     */
+    void pull(std::size_t k) const;
+
+    /**
+     * Move rather than copy into inputs fed by an output that has no other
+     * consumer, for types with a registered mover, when the producing cell
+     * was registered with register_move_source. Other links keep copying.
+     */
+    void move_single_consumer(bool on);
+
+    /**
+     * Applies the edits made to graph since construction or the last
+     * sync. Inserted cells are configured. Returns false if there were none,
+     * throws if this Dataflow does not follow graph.
+     */
+    bool sync(const CircuitGraph &graph);
+private:
+    void insert(std::size_t k, const cell_ptr &cell);
+    void remove(std::size_t k);
+    void connect(const Connection &c);
+    void disconnect(const Connection &c);
+    /** Drops the from -> to dependency unless another link still needs it. */
+    void unlink(std::size_t from, std::size_t to);
+    void resolve_movers();
+
+    std::vector<cell_ptr> cells_;
+    std::vector<std::vector<Link>> links_;
+    std::vector<std::vector<std::size_t>> dependents_;
+    std::vector<std::size_t> upstream_;
+    std::size_t live_;
+    const CircuitGraph *followed_;
+    std::size_t revision_;
+    bool move_ = false;
+};
+
+struct ExecutorStats
+{
+    std::uint64_t processed = 0; //process() calls
+    std::uint64_t retries = 0;   //process() calls that returned DO_OVER
+    std::uint64_t stalls = 0;    //pids abandoned after the stall timeout
+    std::uint64_t skipped = 0;   //cells left alone because nothing changed
+};
+
+/**
+ * The run loop of the single threaded executors over units, which are
+ * cells or chains of cells.
+ *
+ * Units run in the order they became ready. A unit returning DO_OVER is
+ * queued again behind the others, so one slow unit never starves the rest.
+ * Once only retrying units are left the thread sleeps until the earliest
+ * deadline they posted (see wake_at), or yields if any of them posted none. With a stall
+ * timeout above zero, the run is abandoned if no unit finishes for that
+ * long while only retries are left; a zero timeout never abandons it.
+ */
+class TESTERCELL_API ReadyQueue
+{
+public:
+    void clear() {units_.clear(); next_ = 0;}
+    void push(std::size_t u) {units_.push_back(u);}
+
+    /**
+     * Calls process(u, retry) for queued units until none are left, and
+     * release(u) for every unit that returned OK, which pushes the units it
+     * woke. retry is set when u runs again after returning DO_OVER, its
+     * inputs were pulled then and must not be pulled twice (a second move
+     * would swap the values back). Returns OK, the first code other than
+     * OK or DO_OVER, or DO_OVER after a stall.
+     */
+    template<typename Process, typename Release>
+    ReturnCode run(Process process, Release release,
+            std::chrono::milliseconds stall_timeout, ExecutorStats &stats)
+    {
+        typedef std::chrono::steady_clock clock;
+        std::size_t retries_in_a_row = 0;
+        clock::time_point progress = clock::now();
+        bool progressed = false;
+        //earliest deadline posted by the retries since the last sleep, and
+        //whether one of them posted none
+        WakeTime wake = WakeTime::max();
+        bool untimed = false;
+        take_wake_time();
+        while(next_ < units_.size())
+        {
+            //keep the queue from growing without bound on long retry loops,
+            //which append a unit for every DO_OVER
+            if(next_ > 1024 && next_ * 2 > units_.size())
+            {
+                units_.erase(units_.begin(), units_.begin() + next_);
+                next_ = 0;
+            }
+            std::size_t u = units_[next_] & ~RETRY;
+            bool retry = (units_[next_++] & RETRY) != 0;
+            ReturnCode ret = process(u, retry);
+            if(ret == Quantum::DO_OVER)
+            {
+                stats.retries++;
+                units_.push_back(u | RETRY);
+                WakeTime t = take_wake_time();
+                if(t == WakeTime::max())
+                {
+                    untimed = true;
+                }
+                wake = std::min(wake, t);
+                //only units waiting on themselves are left, sleep until
+                //their timers are due rather than burning the core; the
+                //clock is only read on these rounds
+                if(++retries_in_a_row >= units_.size() - next_)
+                {
+                    retries_in_a_row = 0;
+                    if(progressed)
+                    {
+                        progressed = false;
+                        progress = clock::now();
+                    }
+                    else if(stall_timeout.count() > 0 &&
+                            clock::now() - progress > stall_timeout)
+                    {
+                        stats.stalls++;
+                        return Quantum::DO_OVER;
+                    }
+                    if(untimed || wake == WakeTime::max())
+                    {
+                        std::this_thread::yield();
+                    }
+                    else
+                    {
+                        //wake up in time to notice a stall too
+                        if(stall_timeout.count() > 0)
+                        {
+                            wake = std::min(wake, progress + stall_timeout);
+                        }
+                        std::this_thread::sleep_until(wake);
+                    }
+                    wake = WakeTime::max();
+                    untimed = false;
+                }
+                continue;
+            }
+            if(ret != Quantum::OK)
+            {
+                return ret;
+            }
+            retries_in_a_row = 0;
+            progressed = true;
+            wake = WakeTime::max();
+            untimed = false;
+            release(u);
+        }
+        return Quantum::OK;
+    }
+private:
+    //tags a unit queued again after DO_OVER
+    static const std::size_t RETRY = ~(static_cast<std::size_t>(-1) >> 1);
+
+    std::vector<std::size_t> units_;
+    std::size_t next_ = 0;
+};
+
+/**
+ * Executes a circuit pid by pid, waking cells by dependency instead of
+ * polling them.
+ *
+ * A cell is parked until every cell upstream of it has processed the
+ * current pid, then its inputs are pulled and it is processed exactly
+ * once. Only cells that return DO_OVER themselves (such as Delay) are
+ * retried. A cell returning anything other than OK or DO_OVER ends the run
+ * with that code.
+ *
+ * A cell waiting on its own timer (a Delay of minutes) is not told apart
+ * from one that will never finish, so pids are never abandoned by
+ * default. Once stall_timeout() is set, a pid where no cell finishes for
+ * that long is abandoned and execute() returns DO_OVER.
+ *
+ * Edits made to the graph are picked up before each pid, also in the
+ * middle of execute() from the between_pids() hook, without rebuilding the
+ * executor. The graph must outlive the executor.
+ */
+class TESTERCELL_API DataflowExecutor
+{
+public:
+    explicit DataflowExecutor(const CircuitGraph &graph);
+
+    /** Processes pids 0 to n-1. */
+    ReturnCode execute(int n);
+
+    /** Called with the pid about to run, the place to edit the graph. */
+    void between_pids(std::function<void(int)> hook) {between_pids_ = std::move(hook);}
+    /** See Dataflow::move_single_consumer. */
+    void move_single_consumer(bool on) {flow_.move_single_consumer(on);}
+    /** Abandons pids stuck for longer than timeout, zero (the default) never does. */
+    void stall_timeout(std::chrono::milliseconds timeout) {stall_timeout_ = timeout;}
+    const ExecutorStats& stats() const {return stats_;}
+    const Dataflow& dataflow() const {return flow_;}
+private:
+    ReturnCode execute_pid(int pid);
+
+    const CircuitGraph &graph_;
+    std::function<void(int)> between_pids_;
+    Dataflow flow_;
+    std::chrono::milliseconds stall_timeout_;
+    ExecutorStats stats_;
+    std::vector<std::size_t> pending_;
+    ReadyQueue ready_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_DATAFLOW_H_ */
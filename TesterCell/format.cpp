@@ -0,0 +1,107 @@
+/*
+ * format.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/format.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+/**
+ * Appends to a fixed buffer, keeping count of everything that would have
+ * been written had the buffer been large enough.
+ */
+struct Output
+{
+    char *buf;
+    std::size_t size;
+    std::size_t n;
+
+    void add(const char *src, std::size_t len)
+    {
+        if(n < size)
+        {
+            std::memcpy(buf + n, src, std::min(len, size - n));
+        }
+        n += len;
+    }
+
+    template<typename... Args>
+    void print(const char *fmt, Args... args)
+    {
+        char tmp[512]; //enough for any double printed with %f
+        int len = std::snprintf(tmp, sizeof(tmp), fmt, args...);
+        add(tmp, std::min<std::size_t>(len < 0 ? 0 : len, sizeof(tmp) - 1));
+    }
+};
+
+}//namespace
+
+std::size_t format_value(bool v, char *buf, std::size_t size)
+{
+    //matches std::to_string(bool), which the UI has always shown
+    Output out{buf, size, 0};
+    out.add(v ? "1" : "0", 1);
+    return out.n;
+}
+
+std::size_t format_value(int v, char *buf, std::size_t size)
+{
+    Output out{buf, size, 0};
+    out.print("%d", v);
+    return out.n;
+}
+
+std::size_t format_value(double v, char *buf, std::size_t size)
+{
+    Output out{buf, size, 0};
+    out.print("%f", v);
+    return out.n;
+}
+
+std::size_t format_value(ReturnCode v, char *buf, std::size_t size)
+{
+    return format_value(static_cast<int>(v), buf, size);
+}
+
+std::size_t format_value(const std::string &v, char *buf, std::size_t size)
+{
+    Output out{buf, size, 0};
+    out.add(v.data(), v.size());
+    return out.n;
+}
+
+std::size_t format_value(const std::vector<double> &v, char *buf, std::size_t size)
+{
+    //a summary rather than the whole batch: [v0, v1, v2, ... (n)]
+    Output out{buf, size, 0};
+    out.add("[", 1);
+    std::size_t shown = std::min<std::size_t>(v.size(), 3);
+    for(std::size_t k = 0; k < shown; k++)
+    {
+        if(k)
+        {
+            out.add(", ", 2);
+        }
+        out.print("%g", v[k]);
+    }
+    if(v.size() > shown)
+    {
+        out.print(", ... (%zu)", v.size());
+    }
+    out.add("]", 1);
+    return out.n;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,79 @@
+/*
+ * format.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_FORMAT_H_
+#define TESTERCELL_FORMAT_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Render a socket value into a caller supplied buffer. At most size bytes
+ * are written, without a terminating null, and the full length of the
+ * rendering is returned, so a return value larger than size means the
+ * output was truncated (as with snprintf).
+ */
+TESTERCELL_API std::size_t format_value(bool v, char *buf, std::size_t size);
+TESTERCELL_API std::size_t format_value(int v, char *buf, std::size_t size);
+TESTERCELL_API std::size_t format_value(double v, char *buf, std::size_t size);
+TESTERCELL_API std::size_t format_value(ReturnCode v, char *buf, std::size_t size);
+TESTERCELL_API std::size_t format_value(const std::string &v, char *buf, std::size_t size);
+TESTERCELL_API std::size_t format_value(const std::vector<double> &v, char *buf, std::size_t size);
+
+template<typename T>
+std::size_t format_socket(CellSocket &socket, char *buf, std::size_t size)
+{
+    return format_value(socket.get<T>(), buf, size);
+}
+
+/**
+ * Install the str renderer of sockets[name]. Nothing is formatted until the
+ * UI or a debugger calls str(), and then into a stack buffer for short
+ * values.
+ *
+ * The renderer holds a weak reference to the socket it belongs to rather
+ * than the CellSockets holding it, so handing the socket to another
+ * CellSockets (as CellSockets::insert does) keeps it pointing at the right
+ * value. str() is called without the socket, so a renderer copied along
+ * with a whole socket (CellSocket::operator=) still shows the socket it was
+ * installed on, and an empty string once that socket is gone; call
+ * lazy_str() on the copy to bind it to its own value.
+ */
+template<typename T>
+void lazy_str(CellSockets &sockets, const std::string &name)
+{
+    std::weak_ptr<CellSocket> owner = sockets[name];
+    sockets[name]->str = [owner](){
+        cellsocket_ptr socket = owner.lock();
+        if(!socket)
+        {
+            return std::string();
+        }
+        char buf[64];
+        std::size_t n = format_socket<T>(*socket, buf, sizeof(buf));
+        if(n <= sizeof(buf))
+        {
+            return std::string(buf, n);
+        }
+        std::string out(n, '\0');
+        format_socket<T>(*socket, &out[0], n);
+        return out;
+    };
+}
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_FORMAT_H_ */
@@ -0,0 +1,65 @@
+/*
+ * frozen.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/frozen.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+FrozenSchedule::FrozenSchedule(const CircuitGraph &graph)
+{
+    graph.circuit()->configure_all();
+    Dataflow flow(graph);
+    order_ = flow.topological_order();
+    steps_.reserve(order_.size());
+    for(std::size_t k: order_)
+    {
+        for(const Dataflow::Link &l: flow.links(k))
+        {
+            copies_.push_back(Copy{l.from.get(), l.to.get(), l.copy});
+            sockets_.push_back(l.from);
+            sockets_.push_back(l.to);
+        }
+        cells_.push_back(flow.cell(k));
+        steps_.push_back(Step{flow.cell(k).get(), static_cast<std::uint32_t>(copies_.size())});
+    }
+}
+
+ReturnCode FrozenSchedule::execute(int n)
+{
+    const Step *steps = steps_.data();
+    const Step *end = steps + steps_.size();
+    const Copy *copies = copies_.data();
+    for(int pid = 0; pid < n; pid++)
+    {
+        const Copy *copy = copies;
+        for(const Step *s = steps; s != end; ++s)
+        {
+            for(const Copy *last = copies + s->links_end; copy != last; ++copy)
+            {
+                if(copy->inline_copy)
+                {
+                    copy->inline_copy(*copy->to, *copy->from);
+                }
+                else
+                {
+                    *copy->to << *copy->from;
+                }
+            }
+            ReturnCode ret = s->cell->process(pid);
+            if(ret != Quantum::OK)
+            {
+                return ret;
+            }
+        }
+    }
+    return Quantum::OK;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,63 @@
+/*
+ * frozen.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_FROZEN_H_
+#define TESTERCELL_FROZEN_H_
+
+#include "TesterCell/dataflow.h"
+
+#include <cstdint>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * A circuit whose topology no longer changes, compiled into one flat
+ * schedule: cells in a fixed topological order, each preceded by the
+ * socket copies feeding it, all resolved to plain pointers up front.
+ *
+ * execute() is a loop over two arrays with no readiness checks, queues or
+ * topology lookups. That only holds for circuits where every cell can run
+ * once its upstream did: a cell returning anything other than OK ends the
+ * run with that code, DO_OVER included. Edits to the graph after freezing
+ * are not seen, freeze it again instead.
+ */
+class TESTERCELL_API FrozenSchedule
+{
+public:
+    explicit FrozenSchedule(const CircuitGraph &graph);
+
+    /** Processes pids 0 to n-1. */
+    ReturnCode execute(int n);
+
+    std::size_t size() const {return steps_.size();}
+    /** Graph index of the cell run at position k. */
+    std::size_t cell_index(std::size_t k) const {return order_[k];}
+private:
+    struct Step
+    {
+        Cell *cell;
+        std::uint32_t links_end;  //links of this step end here
+    };
+    struct Copy
+    {
+        CellSocket *from, *to;
+        SocketMover inline_copy; //see Dataflow::Link::copy
+    };
+
+    std::vector<cell_ptr> cells_;   //keeps the cells alive
+    std::vector<std::size_t> order_;
+    std::vector<Step> steps_;
+    std::vector<Copy> copies_;
+    std::vector<cellsocket_ptr> sockets_; //keeps the sockets alive
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_FROZEN_H_ */
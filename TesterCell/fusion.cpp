@@ -0,0 +1,177 @@
+/*
+ * fusion.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/fusion.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+/** The cell k can be appended to the chain ending at its only upstream. */
+bool continues_chain(const Dataflow &flow, std::size_t k)
+{
+    if(flow.upstream(k) != 1)
+    {
+        return false;
+    }
+    return flow.dependents(flow.links(k).front().from_cell).size() == 1;
+}
+
+}//namespace
+
+std::vector<std::vector<std::size_t>> fusible_chains(const Dataflow &flow)
+{
+    std::vector<std::vector<std::size_t>> chains;
+    //walking heads in topological order keeps the chains in that order too
+    for(std::size_t k: flow.topological_order())
+    {
+        if(continues_chain(flow, k))
+        {
+            continue;
+        }
+        chains.emplace_back(1, k);
+        std::vector<std::size_t> &chain = chains.back();
+        while(flow.dependents(chain.back()).size() == 1)
+        {
+            std::size_t next = flow.dependents(chain.back()).front();
+            if(flow.upstream(next) != 1)
+            {
+                break;
+            }
+            chain.push_back(next);
+        }
+    }
+    return chains;
+}
+
+FusedExecutor::FusedExecutor(const CircuitGraph &graph):
+        graph_(graph),
+        flow_(graph, true),
+        stall_timeout_(std::chrono::milliseconds::zero())
+{
+    graph.circuit()->configure_all();
+    fuse();
+}
+
+void FusedExecutor::fuse()
+{
+    chains_ = fusible_chains(flow_);
+    std::vector<std::size_t> chain_of(flow_.size());
+    for(std::size_t u = 0; u < chains_.size(); u++)
+    {
+        for(std::size_t k: chains_[u])
+        {
+            chain_of[k] = u;
+        }
+    }
+    //only the tail of a chain feeds other chains and only its head is fed
+    //by them, so chain dependencies are those of the tails and heads
+    dependents_.assign(chains_.size(), std::vector<std::size_t>());
+    upstream_.assign(chains_.size(), 0);
+    handoff_.assign(flow_.size(), nullptr);
+    for(std::size_t u = 0; u < chains_.size(); u++)
+    {
+        const std::vector<std::size_t> &chain = chains_[u];
+        for(std::size_t down: flow_.dependents(chain.back()))
+        {
+            dependents_[u].push_back(chain_of[down]);
+        }
+        upstream_[u] = flow_.upstream(chain.front());
+        //inside a chain each cell has the one link from the cell before
+        for(std::size_t c = 1; c < chain.size(); c++)
+        {
+            const Dataflow::Link &l = flow_.links(chain[c]).front();
+            if(l.to->same_type(*l.from) && is_move_source(*flow_.cell(l.from_cell)))
+            {
+                handoff_[chain[c]] = mover_for(*l.from);
+            }
+        }
+    }
+}
+
+ReturnCode FusedExecutor::execute(int n)
+{
+    for(int pid = 0; pid < n; pid++)
+    {
+        if(between_pids_)
+        {
+            between_pids_(pid);
+        }
+        if(flow_.sync(graph_))
+        {
+            fuse();
+        }
+        ReturnCode ret = execute_pid(pid);
+        if(ret != Quantum::OK)
+        {
+            return ret;
+        }
+    }
+    return Quantum::OK;
+}
+
+ReturnCode FusedExecutor::execute_pid(int pid)
+{
+    pending_.assign(upstream_.begin(), upstream_.end());
+    cursor_.assign(chains_.size(), 0);
+    ready_.clear();
+    for(std::size_t u = 0; u < chains_.size(); u++)
+    {
+        if(!pending_[u])
+        {
+            ready_.push(u);
+        }
+    }
+    auto process = [&](std::size_t u, bool retry)
+    {
+        //a chain that returned DO_OVER resumes at the cell that did, whose
+        //inputs were already pulled
+        const std::vector<std::size_t> &chain = chains_[u];
+        ReturnCode ret = Quantum::OK;
+        bool pulled = retry;
+        for(std::size_t &c = cursor_[u]; c < chain.size(); c++)
+        {
+            if(!pulled)
+            {
+                if(SocketMover move = handoff_[chain[c]])
+                {
+                    const Dataflow::Link &l = flow_.links(chain[c]).front();
+                    move(*l.to, *l.from);
+                }
+                else
+                {
+                    flow_.pull(chain[c]);
+                }
+            }
+            pulled = false;
+            ret = flow_.cell(chain[c])->process(pid);
+            stats_.processed++;
+            if(ret != Quantum::OK)
+            {
+                break;
+            }
+        }
+        return ret;
+    };
+    auto release = [&](std::size_t u)
+    {
+        for(std::size_t down: dependents_[u])
+        {
+            if(--pending_[down] == 0)
+            {
+                ready_.push(down);
+            }
+        }
+    };
+    return ready_.run(process, release, stall_timeout_, stats_);
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,86 @@
+/*
+ * fusion.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_FUSION_H_
+#define TESTERCELL_FUSION_H_
+
+#include "TesterCell/dataflow.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Splits the cells of flow into maximal linear chains: within a chain every
+ * cell feeds only the next one and the next one is fed only by it. Cells
+ * that cannot be fused with a neighbour form a chain of their own, so every
+ * live cell is in exactly one chain. Throws std::runtime_error on cycles.
+ */
+TESTERCELL_API std::vector<std::vector<std::size_t>> fusible_chains(const Dataflow &flow);
+
+/**
+ * DataflowExecutor over fused chains instead of single cells.
+ *
+ * A chain is woken, queued and counted as one unit; inside it the cells run
+ * back to back, each pulling straight from the one before. The link between
+ * two cells of a chain has a single consumer by construction, so the value
+ * is moved into the next cell rather than copied whenever the producer is a
+ * move source (see register_move_source) and its type has a mover; other
+ * values are copied as by Dataflow::pull. Every cell is still processed
+ * through its own Cell::process, so profilers, traces and debug output see
+ * the original cells. A cell returning DO_OVER requeues its chain, which
+ * resumes at that cell.
+ *
+ * Like DataflowExecutor, edits to the graph are picked up before each pid,
+ * and the chains are fused again when the graph changed. The graph must
+ * outlive the executor.
+ */
+class TESTERCELL_API FusedExecutor
+{
+public:
+    explicit FusedExecutor(const CircuitGraph &graph);
+
+    /** Processes pids 0 to n-1. */
+    ReturnCode execute(int n);
+
+    /** Called with the pid about to run, the place to edit the graph. */
+    void between_pids(std::function<void(int)> hook) {between_pids_ = std::move(hook);}
+
+    /** Number of scheduled units, i.e. chains. */
+    std::size_t units() const {return chains_.size();}
+    const std::vector<std::size_t>& chain(std::size_t u) const {return chains_[u];}
+    /** The mover handing cell k its input inside a chain, nullptr if copied. */
+    SocketMover handoff(std::size_t k) const {return handoff_[k];}
+
+    /** See Dataflow::move_single_consumer. */
+    void move_single_consumer(bool on) {flow_.move_single_consumer(on);}
+    /** See DataflowExecutor::stall_timeout. */
+    void stall_timeout(std::chrono::milliseconds timeout) {stall_timeout_ = timeout;}
+    const ExecutorStats& stats() const {return stats_;}
+    const Dataflow& dataflow() const {return flow_;}
+private:
+    /** Splits the dataflow into chains and resolves the handoffs. */
+    void fuse();
+    ReturnCode execute_pid(int pid);
+
+    const CircuitGraph &graph_;
+    std::function<void(int)> between_pids_;
+    Dataflow flow_;
+    std::chrono::milliseconds stall_timeout_;
+    ExecutorStats stats_;
+    std::vector<std::vector<std::size_t>> chains_;
+    std::vector<std::vector<std::size_t>> dependents_; //per chain
+    std::vector<std::size_t> upstream_;                //per chain
+    std::vector<SocketMover> handoff_;                 //per cell
+    std::vector<std::size_t> pending_, cursor_;
+    ReadyQueue ready_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_FUSION_H_ */
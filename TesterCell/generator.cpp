@@ -0,0 +1,179 @@
+/*
+ * generator.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/generator.h"
+#include "TesterCell/tester.h"
+#include "Tests/cells.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+enum PortType {DOUBLE, INT, BOOL, FLOW, PORT_TYPES};
+
+struct Port
+{
+    const char *name;
+    PortType type;
+};
+
+struct Kind
+{
+    cell_ptr prototype;
+    std::vector<Port> inputs;
+    std::vector<Port> outputs;
+    cell_ptr (*make)(const arena_ptr&);
+};
+
+struct Source
+{
+    std::size_t cell;
+    const char *output;
+    std::size_t consumers;
+};
+
+template<typename T>
+cell_ptr prototype()
+{
+    cell_ptr c = std::make_shared<Cell_<T>>();
+    c->declare_params();
+    c->declare_io();
+    return c;
+}
+
+std::vector<std::pair<unsigned, Kind>> kinds(const CellMix &mix)
+{
+    std::vector<std::pair<unsigned, Kind>> k;
+    if(mix.add)
+    {
+        cell_ptr c = prototype<Add>();
+        c->inputs["left"] << 1.0;
+        c->inputs["right"] << 1.0;
+        k.push_back({mix.add, Kind{c,
+            {{"left", DOUBLE}, {"right", DOUBLE}}, {{"out", DOUBLE}}, &make_cell<Add>}});
+    }
+    if(mix.operation)
+    {
+        cell_ptr c = prototype<Operation>();
+        c->inputs["a"] << 1;
+        c->inputs["b"] << 1;
+        k.push_back({mix.operation, Kind{c,
+            {{"a", INT}, {"b", INT}}, {{"ans", INT}}, &make_cell<Operation>}});
+    }
+    if(mix.pause)
+    {
+        cell_ptr c = prototype<Pause>();
+        c->inputs["milliseconds"] << 0;
+        k.push_back({mix.pause, Kind{c, {{"link", BOOL}}, {{"done", BOOL}},
+            &make_cell<Pause>}});
+    }
+    if(mix.branch)
+    {
+        cell_ptr c = prototype<If>();
+        c->inputs["condition"] << true;
+        c->inputs[">>"] << Quantum::OK;
+        k.push_back({mix.branch, Kind{c,
+            {{"condition", BOOL}, {">>", FLOW}},
+            {{"true >>", FLOW}}, &make_cell<If>}});
+    }
+    if(mix.print)
+    {
+        cell_ptr c = prototype<Print>();
+        c->inputs[">>"] << Quantum::OK;
+        k.push_back({mix.print, Kind{c, {{">>", FLOW}}, {{">>", FLOW}},
+            &make_cell<Print>}});
+    }
+    return k;
+}
+
+}//namespace
+
+CircuitGenerator::CircuitGenerator(const GeneratorOptions &options):
+        options_(options)
+{}
+
+circuit_graph_ptr CircuitGenerator::generate() const
+{
+    std::vector<std::pair<unsigned, Kind>> ks = kinds(options_.mix);
+    if(ks.empty())
+    {
+        throw std::runtime_error("CircuitGenerator needs at least one cell type");
+    }
+    unsigned total_weight = 0;
+    for(auto &k: ks)
+    {
+        total_weight += k.first;
+    }
+
+    std::mt19937 rng(options_.seed);
+    auto draw = [&](std::size_t n)
+    {
+        return std::uniform_int_distribution<std::size_t>(0, n - 1)(rng);
+    };
+    auto chance = [&](double p){ return rng() < p * 4294967296.0; };
+    std::size_t cap = std::max<std::size_t>(1, options_.max_fan_out);
+
+    circuit_graph_ptr result(new CircuitGraph);
+    CircuitGraph &graph = *result;
+    std::vector<Source> sources[PORT_TYPES];
+    for(std::size_t n = 0; n < options_.cells; n++)
+    {
+        unsigned pick = static_cast<unsigned>(draw(total_weight));
+        const Kind *kind = nullptr;
+        for(auto &k: ks)
+        {
+            if(pick < k.first)
+            {
+                kind = &k.second;
+                break;
+            }
+            pick -= k.first;
+        }
+
+        cell_ptr c;
+        if(options_.arena)
+        {
+            c = kind->make(options_.arena);
+            copy_values(c, kind->prototype);
+        }
+        else
+        {
+            c = kind->prototype->clone();
+        }
+        std::size_t cell = graph.insert(c);
+        double p = std::min(1.0, options_.fan_in / kind->inputs.size());
+        for(const Port &in: kind->inputs)
+        {
+            std::vector<Source> &pool = sources[in.type];
+            if(pool.empty() || !chance(p))
+            {
+                continue;
+            }
+            std::size_t s = draw(pool.size());
+            graph.connect(pool[s].cell, pool[s].output, cell, in.name);
+            if(++pool[s].consumers >= cap)
+            {
+                pool[s] = pool.back();
+                pool.pop_back();
+            }
+        }
+        for(const Port &out: kind->outputs)
+        {
+            sources[out.type].push_back(Source{cell, out.name, 0});
+        }
+    }
+    return result;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
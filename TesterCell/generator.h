@@ -0,0 +1,71 @@
+/*
+ * generator.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_GENERATOR_H_
+#define TESTERCELL_GENERATOR_H_
+
+#include "TesterCell/arena.h"
+#include "TesterCell/circuit_graph.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Relative weights of the cell types a CircuitGenerator draws from. A weight
+ * of zero leaves the type out. Print writes every token to stdout.
+ */
+struct CellMix
+{
+    unsigned add = 1;       //Add: double left, right -> out
+    unsigned operation = 1; //Operation: int a, b -> ans
+    unsigned pause = 1;     //Pause (0ms): bool link -> done
+    unsigned branch = 1;    //If: bool condition, flow >> -> true >>
+    unsigned print = 1;     //Print: flow >> -> >>
+};
+
+struct GeneratorOptions
+{
+    unsigned seed = 0;
+    std::size_t cells = 100;
+    double fan_in = 1.0;          //average connected inputs per cell
+    std::size_t max_fan_out = 4;  //most consumers of one output
+    CellMix mix;
+    arena_ptr arena;      //when set, cells are made in this arena
+};
+
+/**
+ * Emits reproducible, randomly wired circuits for scale testing.
+ *
+ * Cells are inserted one at a time and each input is wired, with probability
+ * fan_in / inputs, to a uniformly drawn earlier output of the same type, so
+ * the result is always acyclic and every cell index is a valid topological
+ * order. An output stops being drawn once it has max_fan_out consumers.
+ * Inputs that are left unconnected keep a constant value so every cell can
+ * process.
+ *
+ * If cells are generated with a condition that is always true, so only
+ * their "true >>" output ever carries a token and "false >>" is never wired.
+ *
+ * The same options produce the same circuit for a given standard library;
+ * std::uniform_int_distribution is not specified bit for bit, so circuits
+ * may differ between library implementations.
+ */
+class TESTERCELL_API CircuitGenerator
+{
+public:
+    explicit CircuitGenerator(const GeneratorOptions &options);
+    circuit_graph_ptr generate() const;
+    const GeneratorOptions& options() const {return options_;}
+private:
+    GeneratorOptions options_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_GENERATOR_H_ */
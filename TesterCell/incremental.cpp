@@ -0,0 +1,154 @@
+/*
+ * incremental.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/incremental.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace Quantum {
+namespace TesterCell {
+
+IncrementalExecutor::IncrementalExecutor(const CircuitGraph &graph):
+        flow_(graph),
+        stall_timeout_(std::chrono::milliseconds::zero()),
+        rank_(graph.size()),
+        dirty_(graph.size(), 0)
+{
+    graph.circuit()->configure_all();
+    std::vector<std::size_t> order = flow_.topological_order();
+    for(std::size_t pos = 0; pos < order.size(); pos++)
+    {
+        rank_[order[pos]] = pos;
+    }
+    touch_all();
+}
+
+void IncrementalExecutor::touch(std::size_t k)
+{
+    if(k >= flow_.size() || !flow_.cell(k))
+    {
+        throw std::runtime_error("Cell is not part of this circuit graph");
+    }
+    queue(k);
+}
+
+void IncrementalExecutor::touch_all()
+{
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        if(flow_.cell(k))
+        {
+            queue(k);
+        }
+    }
+}
+
+void IncrementalExecutor::queue(std::size_t k)
+{
+    if(dirty_[k])
+    {
+        return;
+    }
+    dirty_[k] = 1;
+    heap_.push_back(k);
+    std::push_heap(heap_.begin(), heap_.end(), Later{&rank_});
+}
+
+ReturnCode IncrementalExecutor::execute()
+{
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        if(!dirty_[k] && flow_.cell(k) && flow_.cell(k)->needs_process())
+        {
+            queue(k);
+        }
+    }
+    std::uint64_t ran = 0;
+    while(!heap_.empty())
+    {
+        std::size_t k = heap_.front();
+        ReturnCode ret = run(k);
+        if(ret != Quantum::OK)
+        {
+            //k and everything still queued stay dirty for the next call
+            return ret;
+        }
+        std::pop_heap(heap_.begin(), heap_.end(), Later{&rank_});
+        heap_.pop_back();
+        dirty_[k] = 0;
+        ran++;
+        for(std::size_t down: flow_.dependents(k))
+        {
+            if(dirty_[down])
+            {
+                continue;
+            }
+            flow_.pull(down);
+            if(flow_.cell(down)->needs_process())
+            {
+                queue(down);
+            }
+        }
+    }
+    stats_.skipped += flow_.live() - ran;
+    pid_++;
+    return Quantum::OK;
+}
+
+ReturnCode IncrementalExecutor::run(std::size_t k)
+{
+    typedef std::chrono::steady_clock clock;
+    for(const Dataflow::Link &l: flow_.links(k))
+    {
+        if(l.copy)
+        {
+            l.copy(*l.to, *l.from);
+        }
+        else
+        {
+            l.to << l.from;
+        }
+        l.to->token_id(pid_);
+    }
+    clock::time_point start = clock::now();
+    take_wake_time();
+    while(true)
+    {
+        ReturnCode ret = flow_.cell(k)->process(pid_);
+        stats_.processed++;
+        if(ret != Quantum::DO_OVER)
+        {
+            return ret;
+        }
+        stats_.retries++;
+        if(stall_timeout_.count() > 0 && clock::now() - start > stall_timeout_)
+        {
+            stats_.stalls++;
+            return Quantum::DO_OVER;
+        }
+        //the cell is all there is to run, wait for its timer if it set one
+        WakeTime wake = take_wake_time();
+        if(wake == WakeTime::max())
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            if(stall_timeout_.count() > 0)
+            {
+                wake = std::min(wake, start + stall_timeout_);
+            }
+            std::this_thread::sleep_until(wake);
+        }
+    }
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,72 @@
+/*
+ * incremental.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_INCREMENTAL_H_
+#define TESTERCELL_INCREMENTAL_H_
+
+#include "TesterCell/dataflow.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Re-executes only the part of a circuit affected by a change.
+ *
+ * The first execute() runs every cell. Later calls start from the cells
+ * that report needs_process(), i.e. whose input sockets changed value
+ * since their last process, plus any cell passed to touch(). Each of them
+ * runs in topological order; its outputs are pulled into its dependents
+ * and a dependent only runs if that changed one of its inputs, so the
+ * dirty cone stops where values stop changing.
+ *
+ * Every execute() is a new pid. Inputs fed by cells that did not need to
+ * run keep their value and are stamped with the new pid.
+ */
+class TESTERCELL_API IncrementalExecutor
+{
+public:
+    explicit IncrementalExecutor(const CircuitGraph &graph);
+
+    ReturnCode execute();
+
+    /**
+     * Runs cell k on the next execute() even if none of its inputs changed,
+     * e.g. after one of its parameters was set. Throws std::runtime_error
+     * if k is not a cell of the graph.
+     */
+    void touch(std::size_t k);
+    void touch_all();
+
+    /** See DataflowExecutor::stall_timeout. */
+    void stall_timeout(std::chrono::milliseconds timeout) {stall_timeout_ = timeout;}
+    int pid() const {return pid_;}
+    const ExecutorStats& stats() const {return stats_;}
+    const Dataflow& dataflow() const {return flow_;}
+private:
+    struct Later
+    {
+        const std::vector<std::size_t> *rank;
+        bool operator()(std::size_t a, std::size_t b) const {return (*rank)[a] > (*rank)[b];}
+    };
+
+    ReturnCode run(std::size_t k);
+    void queue(std::size_t k);
+
+    Dataflow flow_;
+    std::chrono::milliseconds stall_timeout_;
+    ExecutorStats stats_;
+    std::vector<std::size_t> rank_;   //position in topological order
+    std::vector<char> dirty_;
+    std::vector<std::size_t> heap_;   //dirty cells, lowest rank first
+    int pid_ = 0;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_INCREMENTAL_H_ */
@@ -0,0 +1,143 @@
+/*
+ * move.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/move.h"
+#include "TesterCell/batch.h"
+
+#include <initializer_list>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+typedef std::pair<const std::string, SocketMover> Entry;
+
+template<typename T>
+Entry entry(SocketMover transfer)
+{
+    return Entry(make_cellsocket<T>()->type_name(), transfer);
+}
+
+/** Transfer functions by socket type name. */
+struct Transfers
+{
+    Transfers(std::initializer_list<Entry> entries): transfers(entries)
+    {}
+    void add(const std::string &type_name, SocketMover transfer)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        transfers[type_name] = transfer;
+    }
+    SocketMover find(const CellSocket &s)
+    {
+        if(s.is_type<CellSocket::none>())
+        {
+            return nullptr;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = transfers.find(s.type_name());
+        return it == transfers.end() ? nullptr : it->second;
+    }
+    std::mutex mutex;
+    std::unordered_map<std::string, SocketMover> transfers;
+};
+
+Transfers& movers()
+{
+    static Transfers m{
+        entry<std::string>(&move_socket<std::string>),
+        entry<Batch>(&move_socket<Batch>),
+        entry<bp::object>(&move_socket<bp::object>)};
+    return m;
+}
+
+Transfers& inline_copies()
+{
+    static Transfers c{
+        entry<bool>(&copy_inline<bool>),
+        entry<int>(&copy_inline<int>),
+        entry<unsigned>(&copy_inline<unsigned>),
+        entry<float>(&copy_inline<float>),
+        entry<double>(&copy_inline<double>),
+        entry<ReturnCode>(&copy_inline<ReturnCode>)};
+    return c;
+}
+
+/** Cell types whose outputs may be moved from. */
+struct Sources
+{
+    Sources(std::initializer_list<std::type_index> types): types(types)
+    {}
+    std::mutex mutex;
+    std::unordered_set<std::type_index> types;
+};
+
+Sources& sources()
+{
+    static Sources s{
+        typeid(Cell_<BatchAdd>),
+        typeid(Cell_<BatchOperation>),
+        typeid(Cell_<BatchMultiplyAdd>)};
+    return s;
+}
+
+}//namespace
+
+void register_move_source(const std::type_info &cell_type)
+{
+    Sources &s = sources();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.types.insert(cell_type);
+}
+
+bool is_move_source(const Cell &cell)
+{
+    Sources &s = sources();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.types.count(typeid(cell)) != 0;
+}
+
+void register_movable(const std::string &type_name, SocketMover mover)
+{
+    movers().add(type_name, mover);
+}
+
+SocketMover mover_for(const CellSocket &s)
+{
+    return movers().find(s);
+}
+
+void register_inline_copy(const std::string &type_name, SocketMover copy)
+{
+    inline_copies().add(type_name, copy);
+}
+
+SocketMover inline_copy_for(const CellSocket &s)
+{
+    return inline_copies().find(s);
+}
+
+const cellsocket_ptr& operator<<(const cellsocket_ptr &to, Moved m)
+{
+    SocketMover mover = mover_for(*m.from);
+    if(mover && to->same_type(*m.from))
+    {
+        mover(*to, *m.from);
+        return to;
+    }
+    return to << m.from;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,129 @@
+/*
+ * move.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_MOVE_H_
+#define TESTERCELL_MOVE_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace Quantum {
+namespace TesterCell {
+
+/** Moves the value and token id of one socket into another of the same type. */
+typedef void (*SocketMover)(CellSocket &to, CellSocket &from);
+
+/**
+ * Swaps the payloads, so from is left holding the previous value of to.
+ * For buffers that hands the producer back a buffer of the right size to
+ * fill on its next process, instead of an empty one. to is marked dirty and
+ * notified, as the value is taken to have changed.
+ */
+template<typename T>
+void move_socket(CellSocket &to, CellSocket &from)
+{
+    using std::swap;
+    swap(to.get<T>(), from.get<T>());
+    to.token_id(from.token_id());
+    to.dirty(true);
+    to.notify();
+}
+
+/**
+ * Makes sockets holding type_name movable. std::string, Batch and
+ * bp::object are registered up front.
+ */
+TESTERCELL_API void register_movable(const std::string &type_name, SocketMover mover);
+
+template<typename T>
+void register_movable()
+{
+    register_movable(make_cellsocket<T>()->type_name(), &move_socket<T>);
+}
+
+/** The mover for the type held by s, nullptr if it has none. */
+TESTERCELL_API SocketMover mover_for(const CellSocket &s);
+
+/**
+ * Lets executors move out of the outputs of cells of type Impl. Moving
+ * leaves the producer holding a stale value, so only register cells that
+ * write every output on every process; a cell that writes conditionally
+ * (like If) would pass the stale value on as its next result. BatchAdd,
+ * BatchOperation and BatchMultiplyAdd are registered up front.
+ */
+TESTERCELL_API void register_move_source(const std::type_info &cell_type);
+
+template<typename Impl>
+void register_move_source()
+{
+    register_move_source(typeid(Cell_<Impl>));
+}
+
+/** Whether cell was registered with register_move_source. */
+TESTERCELL_API bool is_move_source(const Cell &cell);
+
+/**
+ * Copies a small trivially copyable value by typed insertion, which assigns
+ * into the value to already holds (firing its update notification when the
+ * value changes), and carries the token id over like to << from does.
+ * Socket to socket insertion goes through a copy of the type erased holder
+ * instead, which allocates on every transfer.
+ */
+template<typename T>
+void copy_inline(CellSocket &to, CellSocket &from)
+{
+    static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= 32,
+            "only small trivially copyable values are copied inline");
+    to << from.get<T>();
+    to.token_id(from.token_id());
+}
+
+/**
+ * Makes sockets holding type_name copy inline. bool, int, unsigned, float,
+ * double and ReturnCode are registered up front.
+ */
+TESTERCELL_API void register_inline_copy(const std::string &type_name, SocketMover copy);
+
+template<typename T>
+void register_inline_copy()
+{
+    register_inline_copy(make_cellsocket<T>()->type_name(), &copy_inline<T>);
+}
+
+/** The inline copy for the type held by s, nullptr if it has none. */
+TESTERCELL_API SocketMover inline_copy_for(const CellSocket &s);
+
+struct Moved
+{
+    const cellsocket_ptr &from;
+};
+
+/** Marks a socket to be moved rather than copied: to << moved(from). */
+inline Moved moved(const cellsocket_ptr &from)
+{
+    return Moved{from};
+}
+
+/**
+ * Move insertion. Like to << from the token id is transferred, but the
+ * payload is stolen instead of deep copied, which leaves from with an
+ * unspecified value of its type. Falls back to a copy when to has no type
+ * yet, the types differ (which throws as usual) or the type has no mover.
+ * to is notified like after a copy that changed its value.
+ */
+TESTERCELL_API const cellsocket_ptr& operator<<(const cellsocket_ptr &to, Moved m);
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_MOVE_H_ */
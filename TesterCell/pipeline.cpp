@@ -0,0 +1,296 @@
+/*
+ * pipeline.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/pipeline.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+/** Yield for a while, then back off to short sleeps. */
+void backoff(unsigned &spins)
+{
+    if(++spins < 64)
+    {
+        std::this_thread::yield();
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+}//namespace
+
+/**
+ * Single producer, single consumer ring of socket copies for one
+ * connection between two stages.
+ */
+class PipelineExecutor::Buffer
+{
+public:
+    explicit Buffer(std::size_t depth):
+            head_(0),
+            tail_(0)
+    {
+        for(std::size_t k = 0; k < depth; k++)
+        {
+            slots_.push_back(std::make_shared<CellSocket>());
+        }
+    }
+
+    bool full() const
+    {
+        return tail_.load(std::memory_order_relaxed)
+                - head_.load(std::memory_order_acquire) >= slots_.size();
+    }
+    bool empty() const
+    {
+        return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+    }
+    void put(const cellsocket_ptr &from)
+    {
+        std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        slots_[t % slots_.size()] << from;
+        tail_.store(t + 1, std::memory_order_release);
+    }
+    void take(const cellsocket_ptr &to)
+    {
+        std::uint64_t h = head_.load(std::memory_order_relaxed);
+        to << slots_[h % slots_.size()];
+        head_.store(h + 1, std::memory_order_release);
+    }
+    void reset()
+    {
+        head_ = 0;
+        tail_ = 0;
+    }
+private:
+    std::vector<cellsocket_ptr> slots_;
+    std::atomic<std::uint64_t> head_;
+    char pad_[64 - sizeof(std::atomic<std::uint64_t>)];
+    std::atomic<std::uint64_t> tail_;
+};
+
+PipelineExecutor::PipelineExecutor(const CircuitGraph &graph, std::size_t stages,
+        std::size_t depth):
+        flow_(graph),
+        stall_timeout_(std::chrono::milliseconds::zero()),
+        stopped_(false),
+        result_(Quantum::OK)
+{
+    graph.circuit()->configure_all();
+    std::vector<std::size_t> order = flow_.topological_order();
+    std::size_t n = order.size();
+    stages = std::max<std::size_t>(1, std::min(stages, n));
+    depth = std::max<std::size_t>(1, depth);
+    stages_.resize(stages);
+
+    //stage and step of every cell, filled in as the order is walked so
+    //upstream cells are always known
+    std::vector<std::pair<std::size_t, std::size_t>> where(n);
+    for(std::size_t pos = 0; pos < n; pos++)
+    {
+        std::size_t k = order[pos];
+        std::size_t s = pos * stages / n;
+        Step step;
+        step.cell = k;
+        for(const Dataflow::Link &l: flow_.links(k))
+        {
+            std::size_t from = where[l.from_cell].first;
+            if(from == s)
+            {
+                step.local.push_back(l);
+                continue;
+            }
+            buffers_.emplace_back(new Buffer(depth));
+            Buffer *b = buffers_.back().get();
+            step.in.emplace_back(b, l.to);
+            stages_[from].steps[where[l.from_cell].second].out.emplace_back(l.from, b);
+        }
+        where[k] = std::make_pair(s, stages_[s].steps.size());
+        stages_[s].steps.push_back(std::move(step));
+    }
+}
+
+PipelineExecutor::~PipelineExecutor()
+{
+}
+
+ReturnCode PipelineExecutor::execute(int n)
+{
+    for(std::unique_ptr<Buffer> &b: buffers_)
+    {
+        b->reset();
+    }
+    stopped_ = false;
+    result_ = Quantum::OK;
+
+    std::vector<std::thread> threads;
+    for(std::size_t s = 1; s < stages_.size(); s++)
+    {
+        threads.emplace_back(&PipelineExecutor::run, this, std::ref(stages_[s]), n);
+    }
+    if(!stages_.empty())
+    {
+        run(stages_[0], n);
+    }
+    for(std::thread &t: threads)
+    {
+        t.join();
+    }
+
+    if(error_)
+    {
+        std::exception_ptr e = error_;
+        error_ = nullptr;
+        std::rethrow_exception(e);
+    }
+    return ReturnCode(result_.load());
+}
+
+ExecutorStats PipelineExecutor::stats() const
+{
+    ExecutorStats s;
+    for(const Stage &stage: stages_)
+    {
+        s.processed += stage.processed;
+        s.retries += stage.retries;
+    }
+    s.stalls = stalls_;
+    return s;
+}
+
+void PipelineExecutor::run(Stage &stage, int n)
+{
+    typedef std::chrono::steady_clock clock;
+    for(int pid = 0; pid < n; pid++)
+    {
+        for(Step &step: stage.steps)
+        {
+            for(auto &in: step.in)
+            {
+                unsigned spins = 0;
+                while(in.first->empty())
+                {
+                    if(stopped_.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    backoff(spins);
+                }
+                in.first->take(in.second);
+            }
+            for(const Dataflow::Link &l: step.local)
+            {
+                if(l.copy)
+                {
+                    l.copy(*l.to, *l.from);
+                }
+                else
+                {
+                    l.to << l.from;
+                }
+            }
+
+            ReturnCode ret;
+            clock::time_point since;
+            unsigned spins = 0;
+            take_wake_time();
+            while(true)
+            {
+                try
+                {
+                    ret = flow_.cell(step.cell)->process(pid);
+                }
+                catch(...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex_);
+                    if(!error_)
+                    {
+                        error_ = std::current_exception();
+                    }
+                    stop(Quantum::UNKNOWN);
+                    return;
+                }
+                stage.processed++;
+                if(ret != Quantum::DO_OVER)
+                {
+                    break;
+                }
+                stage.retries++;
+                if(!spins)
+                {
+                    since = clock::now();
+                }
+                else if(stall_timeout_.count() > 0 && clock::now() - since > stall_timeout_)
+                {
+                    if(stop(Quantum::DO_OVER))
+                    {
+                        std::lock_guard<std::mutex> lock(error_mutex_);
+                        stalls_++;
+                    }
+                    return;
+                }
+                if(stopped_.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                //sleep towards the cell's timer if it set one, checking
+                //for a stop every millisecond
+                WakeTime wake = take_wake_time();
+                if(wake == WakeTime::max())
+                {
+                    backoff(spins);
+                }
+                else
+                {
+                    spins++;
+                    std::this_thread::sleep_until(std::min(wake,
+                            clock::now() + std::chrono::milliseconds(1)));
+                }
+            }
+            if(ret != Quantum::OK)
+            {
+                stop(ret);
+                return;
+            }
+
+            for(auto &out: step.out)
+            {
+                unsigned spins = 0;
+                while(out.second->full())
+                {
+                    if(stopped_.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    backoff(spins);
+                }
+                out.second->put(out.first);
+            }
+        }
+    }
+}
+
+bool PipelineExecutor::stop(ReturnCode ret)
+{
+    int ok = Quantum::OK;
+    bool first = result_.compare_exchange_strong(ok, ret);
+    stopped_.store(true, std::memory_order_relaxed);
+    return first;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
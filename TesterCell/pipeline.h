@@ -0,0 +1,82 @@
+/*
+ * pipeline.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_PIPELINE_H_
+#define TESTERCELL_PIPELINE_H_
+
+#include "TesterCell/dataflow.h"
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Executes successive pids concurrently across the stages of a circuit.
+ *
+ * The cells are split in topological order into the given number of
+ * stages, each run by its own thread one pid after the other, so stage k
+ * works on pid p while stage k+1 is still on pid p-1. Connections between
+ * stages go through bounded buffers holding up to depth tokens: a stage
+ * waits when a downstream buffer is full, so no token is overwritten before
+ * it was consumed. Connections inside a stage are pulled directly.
+ *
+ * Throughput approaches one pid per slowest stage; a chain of n cells gets
+ * full pipelining with n stages.
+ */
+class TESTERCELL_API PipelineExecutor
+{
+public:
+    PipelineExecutor(const CircuitGraph &graph, std::size_t stages, std::size_t depth = 4);
+    ~PipelineExecutor();
+
+    /** Processes pids 0 to n-1. */
+    ReturnCode execute(int n);
+
+    /** See DataflowExecutor::stall_timeout. */
+    void stall_timeout(std::chrono::milliseconds timeout) {stall_timeout_ = timeout;}
+    std::size_t stages() const {return stages_.size();}
+    ExecutorStats stats() const;
+    const Dataflow& dataflow() const {return flow_;}
+private:
+    class Buffer;
+    struct Step
+    {
+        std::size_t cell;
+        std::vector<Dataflow::Link> local;              //pulled directly
+        std::vector<std::pair<Buffer*, cellsocket_ptr>> in;  //buffer -> input
+        std::vector<std::pair<cellsocket_ptr, Buffer*>> out; //output -> buffer
+    };
+    struct Stage
+    {
+        std::vector<Step> steps;
+        std::uint64_t processed = 0, retries = 0;
+    };
+
+    void run(Stage &stage, int n);
+    bool stop(ReturnCode ret);
+
+    Dataflow flow_;
+    std::chrono::milliseconds stall_timeout_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+    std::vector<Stage> stages_;
+    std::uint64_t stalls_ = 0;
+
+    std::atomic<bool> stopped_;
+    std::atomic<int> result_;
+    std::exception_ptr error_;
+    std::mutex error_mutex_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_PIPELINE_H_ */
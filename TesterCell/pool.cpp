@@ -0,0 +1,138 @@
+/*
+ * pool.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/pool.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+void restore(const CellSockets &from, CellSockets &to)
+{
+    for(const auto &s: from)
+    {
+        to[s.first] << s.second;
+    }
+}
+
+}//namespace
+
+struct CellPool::State
+{
+    cell_ptr prototype;
+    std::size_t capacity;
+    std::size_t created = 0;
+    mutable std::mutex mutex;
+    std::vector<cell_ptr> free; //each the only reference to its cell
+};
+
+/**
+ * Deleter of the handed out cell_ptr. It owns the pooled cell, so the
+ * cell outlives the handle and can be put back.
+ */
+struct CellPool::Recycle
+{
+    std::weak_ptr<State> pool;
+    cell_ptr cell;
+
+    void operator()(Cell*)
+    {
+        std::shared_ptr<State> state = pool.lock();
+        if(!state)
+        {
+            return;
+        }
+        //this runs in a shared_ptr deleter, where an exception would end in
+        //std::terminate; a cell that cannot be restored is freed instead
+        try
+        {
+            restore(state->prototype->parameters, cell->parameters);
+            restore(state->prototype->inputs, cell->inputs);
+            restore(state->prototype->outputs, cell->outputs);
+        }
+        catch(...)
+        {
+            return;
+        }
+        //as for a fresh clone, which does not copy the profile settings
+        cell->profile[Cell::T_PROCESS] = false;
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if(state->free.size() < state->capacity)
+        {
+            state->free.push_back(std::move(cell));
+        }
+    }
+};
+
+CellPool::CellPool(const cell_ptr &prototype, std::size_t capacity):
+        state_(std::make_shared<State>())
+{
+    if(!prototype)
+    {
+        throw std::runtime_error("CellPool needs a prototype cell");
+    }
+    state_->prototype = prototype;
+    state_->capacity = capacity;
+}
+
+cell_ptr CellPool::acquire()
+{
+    cell_ptr cell;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if(!state_->free.empty())
+        {
+            cell = std::move(state_->free.back());
+            state_->free.pop_back();
+        }
+    }
+    if(!cell)
+    {
+        cell = state_->prototype->clone();
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->created++;
+    }
+    Cell *raw = cell.get();
+    return cell_ptr(raw, Recycle{state_, std::move(cell)});
+}
+
+std::size_t CellPool::created() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->created;
+}
+
+std::size_t CellPool::available() const
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->free.size();
+}
+
+void CellPool::reserve(std::size_t n)
+{
+    std::vector<cell_ptr> made;
+    while(available() + made.size() < n)
+    {
+        made.push_back(state_->prototype->clone());
+    }
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->created += made.size();
+    for(cell_ptr &c: made)
+    {
+        state_->free.push_back(std::move(c));
+    }
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,60 @@
+/*
+ * pool.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_POOL_H_
+#define TESTERCELL_POOL_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Recycles cells of one type for circuits that add and remove cells often.
+ *
+ * acquire() hands out a cell with the values of the prototype, reusing a
+ * released cell when there is one and cloning the prototype otherwise.
+ * A cell goes back to the pool when the last reference to it is dropped,
+ * its parameter, input and output values are then restored from the
+ * prototype, which costs a copy per socket instead of a declare_params()
+ * and declare_io(). Cells dropped after the pool is destroyed are simply
+ * freed. At most capacity released cells are kept.
+ *
+ * Profiling is switched back off as well. A cell whose values cannot be
+ * restored is freed rather than pooled. Observers of a handed out cell
+ * must be gone before its last handle is dropped, as for a cell that is
+ * destroyed; CellProfiler and TraceRecorder hold a handle of their own, so
+ * a cell they observe is not released before they detach.
+ * acquire() may be called from any thread.
+ */
+class TESTERCELL_API CellPool
+{
+public:
+    explicit CellPool(const cell_ptr &prototype, std::size_t capacity = 1024);
+
+    cell_ptr acquire();
+    /** Clones of the prototype made so far, for cells the pool did not have. */
+    std::size_t created() const;
+    /** Released cells waiting to be reused. */
+    std::size_t available() const;
+    /** Make cells until n are waiting to be reused. */
+    void reserve(std::size_t n);
+private:
+    struct State;
+    struct Recycle;
+    std::shared_ptr<State> state_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_POOL_H_ */
@@ -0,0 +1,224 @@
+/*
+ * profiler.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/profiler.h"
+#include "TesterCell/timing.h"
+
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+#include <stdexcept>
+
+namespace Quantum {
+namespace TesterCell {
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+std::size_t LatencyHistogram::bucket(std::uint64_t v)
+{
+    //values below 32 get a bucket each, above that every power of two is
+    //split into 16 buckets
+    if(v < 32)
+    {
+        return static_cast<std::size_t>(v);
+    }
+    int msb = 63;
+    while(!(v >> msb))
+    {
+        msb--;
+    }
+    int shift = msb - 4;
+    return static_cast<std::size_t>(shift * 16 + (v >> shift));
+}
+
+std::uint64_t LatencyHistogram::upper_bound(std::size_t b)
+{
+    if(b < 32)
+    {
+        return b;
+    }
+    std::size_t shift = b / 16 - 1;
+    std::uint64_t top = b - shift * 16;
+    return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::microseconds us)
+{
+    std::uint64_t v = us.count() < 0 ? 0 : static_cast<std::uint64_t>(us.count());
+    counts_[bucket(v)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    std::uint64_t m = max_.load(std::memory_order_relaxed);
+    while(v > m && !max_.compare_exchange_weak(m, v, std::memory_order_relaxed))
+    {}
+}
+
+void LatencyHistogram::reset()
+{
+    for(std::size_t b = 0; b < BUCKETS; b++)
+    {
+        counts_[b] = 0;
+    }
+    count_ = 0;
+    max_ = 0;
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(double p) const
+{
+    std::uint64_t total = count_;
+    if(total == 0)
+    {
+        return std::chrono::microseconds(0);
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(p * total));
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for(std::size_t b = 0; b < BUCKETS; b++)
+    {
+        seen += counts_[b].load(std::memory_order_relaxed);
+        if(seen >= rank)
+        {
+            return std::chrono::microseconds(std::min(upper_bound(b), max_.load()));
+        }
+    }
+    return max();
+}
+
+std::chrono::microseconds LatencyHistogram::max() const
+{
+    return std::chrono::microseconds(max_.load());
+}
+
+struct CellProfiler::Probe: public Observer
+{
+    cell_ptr cell;
+    LatencyHistogram phases[PHASES];
+    bool timed; //holds a request_process_timing
+
+    explicit Probe(const cell_ptr &c): Observer(c.get()), cell(c), timed(false)
+    {}
+    void update(Observable::Event e)
+    {
+        //the cell notifies other events too, only DONE follows a process
+        if(e == Observable::DONE && cell->profile[Cell::T_PROCESS])
+        {
+            phases[PROCESS].record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    cell->us[Cell::T_PROCESS]));
+        }
+    }
+};
+
+CellProfiler::CellProfiler()
+{}
+
+CellProfiler::~CellProfiler()
+{
+    detach();
+}
+
+CellProfiler::Probe& CellProfiler::probe(const cell_ptr &cell)
+{
+    Probe *&p = index_[cell.get()];
+    if(!p)
+    {
+        probes_.emplace_back(new Probe(cell));
+        p = probes_.back().get();
+    }
+    return *p;
+}
+
+void CellProfiler::attach(const cell_ptr &cell)
+{
+    Probe &p = probe(cell);
+    if(!p.timed)
+    {
+        request_process_timing(*cell);
+        p.timed = true;
+    }
+}
+
+void CellProfiler::declare(const cell_ptr &cell)
+{
+    Probe &p = probe(cell);
+    auto t1 = std::chrono::steady_clock::now();
+    cell->declare_params();
+    cell->declare_io();
+    auto t2 = std::chrono::steady_clock::now();
+    p.phases[DECLARE].record(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1));
+}
+
+void CellProfiler::configure(const cell_ptr &cell)
+{
+    Probe &p = probe(cell);
+    auto t1 = std::chrono::steady_clock::now();
+    cell->configure();
+    auto t2 = std::chrono::steady_clock::now();
+    p.phases[CONFIGURE].record(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1));
+}
+
+void CellProfiler::detach()
+{
+    for(auto &p: probes_)
+    {
+        if(p->timed)
+        {
+            release_process_timing(*p->cell);
+        }
+    }
+    index_.clear();
+    probes_.clear();
+}
+
+const LatencyHistogram& CellProfiler::histogram(const cell_ptr &cell, Phase phase) const
+{
+    auto it = index_.find(cell.get());
+    if(it == index_.end())
+    {
+        throw std::runtime_error("Cell is not being profiled");
+    }
+    return it->second->phases[phase];
+}
+
+void CellProfiler::dump(std::ostream &out) const
+{
+    static const char *names[PHASES] = {"declare", "configure", "process"};
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-24s %-10s %10s %10s %10s %10s %10s\n",
+            "cell", "phase", "count", "p50 us", "p99 us", "p999 us", "max us");
+    out << line;
+    for(std::size_t k = 0; k < probes_.size(); k++)
+    {
+        const Probe &p = *probes_[k];
+        std::string name = p.cell->name();
+        if(name.empty())
+        {
+            name = "#" + std::to_string(k);
+        }
+        for(int phase = 0; phase < PHASES; phase++)
+        {
+            const LatencyHistogram &h = p.phases[phase];
+            if(!h.count())
+            {
+                continue;
+            }
+            std::snprintf(line, sizeof(line), "%-24s %-10s %10llu %10lld %10lld %10lld %10lld\n",
+                    name.c_str(), names[phase],
+                    static_cast<unsigned long long>(h.count()),
+                    static_cast<long long>(h.percentile(0.5).count()),
+                    static_cast<long long>(h.percentile(0.99).count()),
+                    static_cast<long long>(h.percentile(0.999).count()),
+                    static_cast<long long>(h.max().count()));
+            out << line;
+        }
+    }
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,88 @@
+/*
+ * profiler.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_PROFILER_H_
+#define TESTERCELL_PROFILER_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Log-linear latency histogram in the style of HdrHistogram. Values below
+ * 32us are exact, larger values fall in buckets at most 1/16 (6.25%) wide.
+ * record() is lock-free and can be called from any thread.
+ */
+class TESTERCELL_API LatencyHistogram
+{
+public:
+    LatencyHistogram();
+    void record(std::chrono::microseconds us);
+    void reset();
+
+    std::uint64_t count() const {return count_;}
+    /** Upper bound of the bucket holding the p-th quantile, p in [0, 1]. */
+    std::chrono::microseconds percentile(double p) const;
+    std::chrono::microseconds max() const;
+private:
+    static const std::size_t BUCKETS = 976;
+    static std::size_t bucket(std::uint64_t v);
+    static std::uint64_t upper_bound(std::size_t bucket);
+
+    std::atomic<std::uint64_t> counts_[BUCKETS];
+    std::atomic<std::uint64_t> count_, max_;
+};
+
+/**
+ * Per-cell latency histograms for the declare, configure and process
+ * phases.
+ *
+ * attach() requests Cell::profile[Cell::T_PROCESS] (see
+ * request_process_timing) and observes the cell, so every process call made
+ * by a Scheduler lands in the cell's histogram through
+ * Cell::us[Cell::T_PROCESS]. declare() and configure() run those phases of
+ * a cell and time them. Cells that were never attached cost nothing.
+ */
+class TESTERCELL_API CellProfiler
+{
+public:
+    enum Phase {DECLARE, CONFIGURE, PROCESS, PHASES};
+
+    CellProfiler();
+    ~CellProfiler();
+
+    void attach(const cell_ptr &cell);
+    void declare(const cell_ptr &cell);
+    void configure(const cell_ptr &cell);
+    /** Stop observing every cell and release their profiling. */
+    void detach();
+
+    const LatencyHistogram& histogram(const cell_ptr &cell, Phase phase) const;
+    /** One line per cell and phase with count, p50, p99, p99.9 and max. */
+    void dump(std::ostream &out) const;
+private:
+    struct Probe;
+    Probe& probe(const cell_ptr &cell);
+    std::vector<std::unique_ptr<Probe>> probes_; //in attach order, for dump()
+    std::unordered_map<const Cell*, Probe*> index_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_PROFILER_H_ */
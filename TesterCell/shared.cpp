@@ -0,0 +1,85 @@
+/*
+ * shared.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/shared.h"
+#include "TesterCell/format.h"
+
+#include <boost/python.hpp>
+
+#include <mutex>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+struct SharedBatchToPython
+{
+    static PyObject* convert(const SharedBatch &s)
+    {
+        bp::list l;
+        for(double d: *s)
+        {
+            l.append(d);
+        }
+        return bp::incref(l.ptr());
+    }
+};
+
+struct SharedBatchFromPython
+{
+    static void* convertible(PyObject *o)
+    {
+        return PySequence_Check(o) ? o : nullptr;
+    }
+    static void construct(PyObject *o, bp::converter::rvalue_from_python_stage1_data *data)
+    {
+        bp::object seq(bp::handle<>(bp::borrowed(o)));
+        Batch b(bp::len(seq));
+        for(std::size_t k = 0; k < b.size(); k++)
+        {
+            b[k] = bp::extract<double>(seq[k]);
+        }
+        void *storage = reinterpret_cast<bp::converter::rvalue_from_python_storage<SharedBatch>*>(
+                data)->storage.bytes;
+        new (storage) SharedBatch(std::move(b));
+        data->convertible = storage;
+    }
+};
+
+}//namespace
+
+void register_shared_types()
+{
+    static std::once_flag once;
+    std::call_once(once, []()
+    {
+        make_cellsocket<SharedBatch>();
+        bp::to_python_converter<SharedBatch, SharedBatchToPython>();
+        bp::converter::registry::push_back(&SharedBatchFromPython::convertible,
+                &SharedBatchFromPython::construct, bp::type_id<SharedBatch>());
+    });
+}
+
+void Broadcast::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
+{
+    i.declare(&Broadcast::in_, "in");
+    lazy_str<Batch>(i, "in");
+    o.declare(&Broadcast::out_, "out");
+    lazy_str<SharedBatch>(o, "out");
+}
+
+ReturnCode Broadcast::process(const CellSockets &i, const CellSockets &o)
+{
+    *out_ = SharedBatch(*in_);
+    return Quantum::OK;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
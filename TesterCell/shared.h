@@ -0,0 +1,91 @@
+/*
+ * shared.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_SHARED_H_
+#define TESTERCELL_SHARED_H_
+
+#include "Engine/kernel.h"
+#include "TesterCell/batch.h"
+#include "testercell_config.h"
+
+#include <memory>
+#include <utility>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Refcounted immutable payload for sockets. Copying a Shared, which is what
+ * every socket transfer does, only copies a pointer, so an output fanned out
+ * to any number of inputs is held in one allocation.
+ *
+ * Readers get const access. mutate() gives write access and first copies
+ * the payload if anyone else still holds it (copy-on-write), so a consumer
+ * changing its input never affects the producer or the other consumers.
+ */
+template<typename T>
+class Shared
+{
+public:
+    Shared(): ptr_(std::make_shared<T>()) {}
+    Shared(T value): ptr_(std::make_shared<T>(std::move(value))) {}
+
+    const T& get() const {return *ptr_;}
+    const T& operator*() const {return *ptr_;}
+    const T* operator->() const {return ptr_.get();}
+    operator const T&() const {return *ptr_;}
+
+    T& mutate()
+    {
+        //only we can raise the count of a payload we hold alone, so a count
+        //of one cannot go stale between the check and the write
+        if(ptr_.use_count() != 1)
+        {
+            ptr_ = std::make_shared<T>(*ptr_);
+        }
+        return *ptr_;
+    }
+
+    /** Number of Shared values holding this payload. */
+    long use_count() const {return ptr_.use_count();}
+
+    bool operator==(const Shared &other) const
+    {
+        return ptr_ == other.ptr_ || *ptr_ == *other.ptr_;
+    }
+    bool operator!=(const Shared &other) const {return !(*this == other);}
+private:
+    std::shared_ptr<T> ptr_;
+};
+
+typedef Shared<Batch> SharedBatch;
+
+/**
+ * Registers SharedBatch with the socket type registry and with Python,
+ * where it converts to and from a list of floats. Safe to call repeatedly.
+ */
+TESTERCELL_API void register_shared_types();
+
+/**
+ * Turns a Batch into a SharedBatch, copying it once so any number of
+ * consumers can read it without further copies.
+ */
+class TESTERCELL_API Broadcast
+{
+public:
+    static void declare_params(CellSockets &p){}
+    static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
+    ReturnCode process(const CellSockets &i, const CellSockets &o);
+    SocketHandle<Batch> in_;
+    SocketHandle<SharedBatch> out_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_SHARED_H_ */
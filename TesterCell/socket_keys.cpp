@@ -0,0 +1,115 @@
+/*
+ * socket_keys.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/socket_keys.h"
+
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+struct Names
+{
+    std::uint32_t intern(const std::string &name)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ids.find(name);
+        if(it != ids.end())
+        {
+            return it->second;
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(names.size());
+        names.push_back(name);
+        ids.emplace(name, id);
+        return id;
+    }
+    const std::string& name(std::uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return names[id];
+    }
+    const std::string* interned(const std::string &name)
+    {
+        return &this->name(intern(name));
+    }
+    std::mutex mutex;
+    std::deque<std::string> names; //by id, a deque so references stay valid
+    std::unordered_map<std::string, std::uint32_t> ids;
+};
+
+Names& names()
+{
+    static Names n;
+    return n;
+}
+
+Names& type_names()
+{
+    static Names n;
+    return n;
+}
+
+}//namespace
+
+TypeId type_id(const CellSocket &s)
+{
+    if(s.is_type<CellSocket::none>())
+    {
+        return nullptr;
+    }
+    return type_names().interned(s.type_name());
+}
+
+SocketKey::SocketKey(const std::string &name):
+        id_(names().intern(name))
+{
+}
+
+const std::string& SocketKey::name() const
+{
+    return names().name(id_);
+}
+
+SocketTable::SocketTable(const CellSockets &sockets)
+{
+    for(const auto &s: sockets)
+    {
+        SocketKey key(s.first);
+        if(key.id() >= slots_.size())
+        {
+            slots_.resize(key.id() + 1);
+        }
+        slots_[key.id()].socket = s.second;
+        slots_[key.id()].type = type_id(*s.second);
+    }
+    size_ = sockets.size();
+}
+
+bool SocketTable::contains(SocketKey key) const
+{
+    return key.id() < slots_.size() && slots_[key.id()].socket;
+}
+
+void SocketTable::missing(SocketKey key)
+{
+    throw std::runtime_error("No socket named " + key.name());
+}
+
+void SocketTable::wrong_type(SocketKey key, const CellSocket &s)
+{
+    throw std::runtime_error("Socket " + key.name() + " holds a " + s.type_name());
+}
+
+}//namespace TesterCell
+}//namespace Quantum
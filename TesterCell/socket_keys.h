@@ -0,0 +1,127 @@
+/*
+ * socket_keys.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_SOCKET_KEYS_H_
+#define TESTERCELL_SOCKET_KEYS_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Identity of a socket value type: the engine's name for the type,
+ * interned, so comparing two types is one pointer compare. Ids come from
+ * one process wide table, sockets of the same type get the same id
+ * whichever module made them.
+ */
+typedef const std::string* TypeId;
+
+/** The id of the type held by s, nullptr for a socket without a type yet. */
+TESTERCELL_API TypeId type_id(const CellSocket &s);
+
+/** The id sockets holding a T have. */
+template<typename T>
+TypeId type_id()
+{
+    static const TypeId id = type_id(*make_cellsocket<T>());
+    return id;
+}
+
+/**
+ * A socket name interned to a small integer. Keys are process wide, the
+ * same name always gives the same key, so a key can be made once (as a
+ * static or a member) and used on the sockets of every cell.
+ */
+class TESTERCELL_API SocketKey
+{
+public:
+    explicit SocketKey(const std::string &name);
+    std::uint32_t id() const {return id_;}
+    const std::string& name() const;
+    bool operator==(SocketKey other) const {return id_ == other.id_;}
+    bool operator!=(SocketKey other) const {return id_ != other.id_;}
+private:
+    std::uint32_t id_;
+};
+
+/**
+ * Index over the sockets of a CellSockets by SocketKey. Lookup is an array
+ * access. The type of every socket is resolved to a TypeId when the table
+ * is built, get<T>() checks it with one compare and resolves it again only
+ * when that fails, which is how it notices a socket whose value was
+ * replaced by one of another type. The value itself is read from the
+ * socket on every call, so it follows the socket when its storage is
+ * replaced (assigning one socket to another, for instance) rather than
+ * caching a pointer that could dangle.
+ *
+ * Build it once the sockets are declared, typically in configure(), and
+ * rebuild it if sockets are declared later. The string API of CellSockets
+ * keeps working alongside it. Not thread safe, like the cell owning it.
+ */
+class TESTERCELL_API SocketTable
+{
+public:
+    SocketTable() {}
+    explicit SocketTable(const CellSockets &sockets);
+
+    /** Number of sockets indexed. */
+    std::size_t size() const {return size_;}
+    bool contains(SocketKey key) const;
+
+    /** Throws std::runtime_error if there is no such socket. */
+    const cellsocket_ptr& operator[](SocketKey key) const {return slot(key).socket;}
+
+    /**
+     * The value of a socket, throws std::runtime_error if there is no such
+     * socket or it does not hold a T.
+     */
+    template<typename T>
+    T& get(SocketKey key) const
+    {
+        const Slot &s = slot(key);
+        if(s.type != type_id<T>())
+        {
+            s.type = type_id(*s.socket);
+            if(s.type != type_id<T>())
+            {
+                wrong_type(key, *s.socket);
+            }
+        }
+        return s.socket->get<T>();
+    }
+private:
+    struct Slot
+    {
+        cellsocket_ptr socket;
+        mutable TypeId type = nullptr;
+    };
+    const Slot& slot(SocketKey key) const
+    {
+        if(key.id() >= slots_.size() || !slots_[key.id()].socket)
+        {
+            missing(key);
+        }
+        return slots_[key.id()];
+    }
+    [[noreturn]] static void missing(SocketKey key);
+    [[noreturn]] static void wrong_type(SocketKey key, const CellSocket &s);
+
+    std::vector<Slot> slots_; //by key id
+    std::size_t size_ = 0;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_SOCKET_KEYS_H_ */
@@ -8,10 +8,32 @@
  */
 
 #include "TesterCell/tester.h"
+#include "TesterCell/async_writer.h"
+#include "TesterCell/format.h"
 
 namespace Quantum {
 namespace TesterCell {
 
+namespace {
+
+/**
+ * Writes through a handle the way socket << value does: the update
+ * notification fires only when the value changes.
+ */
+template<typename T>
+void write(SocketHandle<T> &socket, const T &value)
+{
+    if(*socket == value)
+    {
+        return;
+    }
+    *socket = value;
+    socket.dirty(true);
+    socket.notify();
+}
+
+}//namespace
+
 If::If():ret_msg_("")
 {}
 
@@ -22,68 +44,77 @@ void If::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
 {
     i.declare<bool>("condition", "A true or false condition");
     i["condition"]->required(true);
-    i["condition"]->str = [=, &i](){
-        return std::to_string(i.get<bool>("condition"));
-    };
+    lazy_str<bool>(i, "condition");
     i.declare<ReturnCode>(">>", "Execution flow");
     i[">>"]->required(true);
-    i[">>"]->str = [=, &i](){
-        return std::to_string(static_cast<int>(i.get<ReturnCode>(">>")));
-    };
+    lazy_str<ReturnCode>(i, ">>");
 
     o.declare<ReturnCode>("true >>", "Execute if true");
-    o["true >>"]->str = [=, &o](){
-        return std::to_string(static_cast<int>(o.get<ReturnCode>("true >>")));
-    };
+    lazy_str<ReturnCode>(o, "true >>");
     o.declare<ReturnCode>("false >>", "Else execute if false");
-    o["false >>"]->str = [=, &o](){
-        return std::to_string(static_cast<int>(o.get<ReturnCode>("false >>")));
-    };
+    lazy_str<ReturnCode>(o, "false >>");
 }
-/*
+
 void If::configure(const CellSockets &p, const CellSockets &i,
         const CellSockets &o)
-{}*/
+{
+    condition_ = i["condition"];
+    true_ = o["true >>"];
+    false_ = o["false >>"];
+}
 
 ReturnCode If::process(const CellSockets& i, const CellSockets& o)
 {
-    if(i.get<bool>("condition"))
+    if(*condition_)
     {
-        o["true >>"] << Quantum::OK;
+        write(true_, Quantum::OK);
     }
     else
     {
-        o["false >>"] << Quantum::OK;
+        write(false_, Quantum::OK);
     }
     return Quantum::OK;
 }
 
-Print::Print():ret_msg_(""){}
+Print::Print():ret_msg_(""), buffered_(false){}
 
-void Print::declare_params(CellSockets &p){}
+void Print::declare_params(CellSockets &p)
+{
+    p.declare<bool>("buffered", "Hand messages to a background writer "
+            "instead of writing to stdout from the scheduler thread", false);
+}
 
 void Print::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
 {
     i.declare<ReturnCode>(">>", "Put status here.", Quantum::UNKNOWN);
     i[">>"]->required(true);
-    i[">>"]->str = [=, &i](){
-        return std::to_string(static_cast<int>(i.get<ReturnCode>(">>")));
-    };
+    lazy_str<ReturnCode>(i, ">>");
     i.declare<std::string>("msg", "Put message here.", "Hello World!");
-    i["msg"]->str = [=, &i](){
-        return i.get<std::string>("msg");
-    };
+    lazy_str<std::string>(i, "msg");
 
     o.declare<ReturnCode>(">>", "", Quantum::UNKNOWN);
-    o[">>"]->str = [=, &o](){
-        return std::to_string(static_cast<int>(o.get<ReturnCode>(">>")));
-    };
+    lazy_str<ReturnCode>(o, ">>");
+}
+
+void Print::configure(const CellSockets &p, const CellSockets &i,
+        const CellSockets &o)
+{
+    msg_ = i["msg"];
+    out_ = o[">>"];
+    buffered_ = p.get<bool>("buffered");
 }
 
 ReturnCode Print::process(const CellSockets &i, const CellSockets &o)
 {
-    std::cout<<i.get<std::string>("msg")<<std::endl;
-    o[">>"] << Quantum::OK;
+    if(buffered_)
+    {
+        AsyncWriter::standard_output().write(*msg_ + '\n');
+    }
+    else
+    {
+        std::cout<<*msg_<<std::endl;
+    }
+    write(out_, Quantum::OK);
     return Quantum::OK;
 }
 
@@ -92,14 +123,18 @@ Start::Start():ret_msg_(""){}
 void Start::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
 {
     o.declare<ReturnCode>(">>", "", Quantum::OK);
-    o[">>"]->str = [=, &o](){
-        return std::to_string(static_cast<int>(o.get<ReturnCode>(">>")));
-    };
+    lazy_str<ReturnCode>(o, ">>");
+}
+
+void Start::configure(const CellSockets &p, const CellSockets &i,
+        const CellSockets &o)
+{
+    out_ = o[">>"];
 }
 
 ReturnCode Start::process(const CellSockets &i, const CellSockets &o)
 {
-    o[">>"] << Quantum::OK;
+    write(out_, Quantum::OK);
     return Quantum::OK;
 }
 
@@ -108,14 +143,18 @@ Hello::Hello(){}
 void Hello::declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
 {
     o.declare<std::string>("msg", "Say hello", "Hi there!");
-    o["msg"]->str = [=, &o](){
-        return o.get<std::string>("msg");
-    };
+    lazy_str<std::string>(o, "msg");
+}
+
+void Hello::configure(const CellSockets &p, const CellSockets &i,
+        const CellSockets &o)
+{
+    msg_ = o["msg"];
 }
 
 ReturnCode Hello::process(const CellSockets &i, const CellSockets &o)
 {
-    o["msg"] << std::string("Helloooooo!");
+    write(msg_, std::string("Helloooooo!"));
     return Quantum::OK;
 }
 
@@ -22,11 +22,13 @@ public:
     If();
     static void declare_params(CellSockets&);
     static void declare_io(const CellSockets&, CellSockets&, CellSockets&);
-    //void configure(const CellSockets&, const CellSockets&, const CellSockets&);
+    void configure(const CellSockets&, const CellSockets&, const CellSockets&);
     ReturnCode process(const CellSockets&, const CellSockets&);
     const std::string return_msg(){return ret_msg_;}
 private:
     std::string ret_msg_;
+    SocketHandle<bool> condition_;
+    SocketHandle<ReturnCode> true_, false_;
 };
 
 class TESTERCELL_API Print
@@ -35,11 +37,14 @@ public:
     Print();
     static void declare_params(CellSockets&);
     static void declare_io(const CellSockets&, CellSockets&, CellSockets&);
-    //void configure(const CellSockets&, const CellSockets&, const CellSockets&);
+    void configure(const CellSockets&, const CellSockets&, const CellSockets&);
     ReturnCode process(const CellSockets&, const CellSockets&);
     const std::string return_msg(){return ret_msg_;}
 private:
     std::string ret_msg_;
+    bool buffered_;
+    SocketHandle<std::string> msg_;
+    SocketHandle<ReturnCode> out_;
 };
 
 class TESTERCELL_API Start
@@ -48,11 +53,12 @@ public:
     Start();
     static void declare_params(CellSockets &p){}
     static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
-    //void configure(const CellSockets&, const CellSockets&, const CellSockets&);
+    void configure(const CellSockets&, const CellSockets&, const CellSockets&);
     ReturnCode process(const CellSockets&, const CellSockets&);
     const std::string return_msg(){return ret_msg_;}
 private:
     std::string ret_msg_;
+    SocketHandle<ReturnCode> out_;
 };
 
 class TESTERCELL_API Hello
@@ -61,7 +67,10 @@ public:
     Hello();
     static void declare_params(CellSockets &p){}
     static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o);
+    void configure(const CellSockets&, const CellSockets&, const CellSockets&);
     ReturnCode process(const CellSockets&, const CellSockets&);
+private:
+    SocketHandle<std::string> msg_;
 };
 
 }//namespace TesterCell
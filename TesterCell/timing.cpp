@@ -0,0 +1,58 @@
+/*
+ * timing.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/timing.h"
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+struct Requests
+{
+    std::size_t count;
+    bool was_on;
+};
+
+std::mutex requests_mutex;
+std::unordered_map<const Cell*, Requests> requests;
+
+}//namespace
+
+void request_process_timing(Cell &cell)
+{
+    std::lock_guard<std::mutex> lock(requests_mutex);
+    Requests &r = requests[&cell];
+    if(r.count++ == 0)
+    {
+        r.was_on = cell.profile[Cell::T_PROCESS];
+        cell.profile[Cell::T_PROCESS] = true;
+    }
+}
+
+void release_process_timing(Cell &cell)
+{
+    std::lock_guard<std::mutex> lock(requests_mutex);
+    auto it = requests.find(&cell);
+    if(it == requests.end())
+    {
+        return;
+    }
+    if(--it->second.count == 0)
+    {
+        cell.profile[Cell::T_PROCESS] = it->second.was_on;
+        requests.erase(it);
+    }
+}
+
+}//namespace TesterCell
+}//namespace Quantum
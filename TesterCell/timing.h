@@ -0,0 +1,30 @@
+/*
+ * timing.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_TIMING_H_
+#define TESTERCELL_TIMING_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Reference counted Cell::profile[Cell::T_PROCESS], for observers that need
+ * Cell::us[Cell::T_PROCESS] filled in. The first request turns the flag on,
+ * the last release restores it to what it was before, so a CellProfiler and
+ * a TraceRecorder can watch the same cell and detach in any order.
+ */
+TESTERCELL_API void request_process_timing(Cell &cell);
+TESTERCELL_API void release_process_timing(Cell &cell);
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_TIMING_H_ */
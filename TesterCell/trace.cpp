@@ -0,0 +1,227 @@
+/*
+ * trace.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/trace.h"
+#include "TesterCell/timing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace {
+
+std::atomic<std::uint64_t> next_recorder_id(1);
+
+void write_json_string(std::ostream &out, const std::string &s)
+{
+    out << '"';
+    for(char c: s)
+    {
+        switch(c)
+        {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        default:
+            if(static_cast<unsigned char>(c) >= 0x20)
+            {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+}
+
+}//namespace
+
+struct TraceRecorder::Probe: public Observer
+{
+    TraceRecorder &recorder;
+    cell_ptr cell;
+    std::int32_t index;
+    int run;                     //run the pids below belong to
+    std::int32_t done, attempt;  //last pid finished, calls spent on the next
+
+    Probe(TraceRecorder &r, const cell_ptr &c, std::int32_t k):
+        Observer(c.get()), recorder(r), cell(c), index(k), run(-1), done(-1), attempt(0)
+    {}
+
+    /**
+     * The newest token on the cell's outputs, or on its inputs if it has
+     * none. Finishing process(pid) stamps pid on the outputs the cell wrote
+     * and never a later one, so which output comes first does not matter.
+     */
+    std::int32_t newest_token() const
+    {
+        const CellSockets &sockets = cell->outputs.empty() ? cell->inputs : cell->outputs;
+        std::int32_t t = -1;
+        for(const auto &s: sockets)
+        {
+            t = std::max<std::int32_t>(t, s.second->token_id());
+        }
+        return t;
+    }
+
+    void update(Observable::Event e)
+    {
+        //the cell notifies other events too, only DONE follows a process
+        if(e != Observable::DONE)
+        {
+            return;
+        }
+        std::int64_t end = recorder.now();
+        std::int64_t dur = std::chrono::duration_cast<std::chrono::microseconds>(
+                cell->us[Cell::T_PROCESS]).count();
+        int r = recorder.runs_;
+        if(r != run)
+        {
+            //every Scheduler run starts over at pid 0
+            run = r;
+            done = -1;
+            attempt = 0;
+        }
+        attempt++;
+        std::int32_t t = newest_token();
+        if(t > done)
+        {
+            //returned OK for pid t, after attempt - 1 DO_OVERs
+            recorder.record(Event{end - dur, dur, index, t, attempt, Quantum::OK});
+            done = t;
+            attempt = 0;
+        }
+        else
+        {
+            //nothing was stamped, the next pid is to be retried
+            recorder.record(Event{end - dur, dur, index, done + 1, attempt, Quantum::DO_OVER});
+        }
+    }
+};
+
+TraceRecorder::TraceRecorder():
+        id_(next_recorder_id++),
+        epoch_(std::chrono::steady_clock::now()),
+        runs_(0)
+{}
+
+TraceRecorder::~TraceRecorder()
+{
+    detach();
+}
+
+void TraceRecorder::attach(const cell_ptr &cell)
+{
+    request_process_timing(*cell);
+    probes_.emplace_back(new Probe(*this, cell, static_cast<std::int32_t>(probes_.size())));
+}
+
+void TraceRecorder::detach()
+{
+    for(auto &p: probes_)
+    {
+        release_process_timing(*p->cell);
+    }
+    probes_.clear();
+}
+
+int TraceRecorder::execute(Scheduler &sched, int n)
+{
+    std::int32_t run = runs_++;
+    std::int64_t start = now();
+    int ret = sched.execute(n);
+    record(Event{start, now() - start, -1, run, n, ret});
+    return ret;
+}
+
+std::int64_t TraceRecorder::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - epoch_).count();
+}
+
+TraceRecorder::ThreadBuffer& TraceRecorder::buffer()
+{
+    //keyed by recorder id rather than address so a recorder created where
+    //an old one lived never picks up a dangling buffer
+    thread_local std::unordered_map<std::uint64_t, ThreadBuffer*> mine;
+    ThreadBuffer *&b = mine[id_];
+    if(!b)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.emplace_back(new ThreadBuffer{static_cast<int>(buffers_.size()), {}});
+        buffers_.back()->events.reserve(4096);
+        b = buffers_.back().get();
+    }
+    return *b;
+}
+
+void TraceRecorder::record(const Event &e)
+{
+    buffer().events.push_back(e);
+}
+
+void TraceRecorder::write(std::ostream &out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    for(const auto &b: buffers_)
+    {
+        if(!first) out << ",\n";
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << b->tid
+            << ",\"args\":{\"name\":\"worker " << b->tid << "\"}}";
+        for(const Event &e: b->events)
+        {
+            out << ",\n{\"name\":";
+            if(e.cell < 0)
+            {
+                out << "\"execute(" << e.attempt << ")\",\"cat\":\"run\"";
+            }
+            else
+            {
+                std::string name = probes_.size() > static_cast<std::size_t>(e.cell) ?
+                        probes_[e.cell]->cell->name() : std::string();
+                write_json_string(out, name.empty() ? "#" + std::to_string(e.cell) : name);
+                out << ",\"cat\":\"cell\"";
+            }
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid
+                << ",\"ts\":" << e.ts << ",\"dur\":" << e.dur << ",\"args\":{";
+            if(e.cell < 0)
+            {
+                out << "\"run\":" << e.pid << ",\"pids\":" << e.attempt
+                    << ",\"result\":" << e.ret;
+            }
+            else
+            {
+                out << "\"pid\":" << e.pid << ",\"attempt\":" << e.attempt
+                    << ",\"result\":" << e.ret;
+            }
+            out << "}}";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void TraceRecorder::write(const std::string &path) const
+{
+    std::ofstream out(path.c_str());
+    if(!out)
+    {
+        throw std::runtime_error("Could not open trace file " + path);
+    }
+    write(out);
+}
+
+}//namespace TesterCell
+}//namespace Quantum
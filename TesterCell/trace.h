@@ -0,0 +1,92 @@
+/*
+ * trace.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_TRACE_H_
+#define TESTERCELL_TRACE_H_
+
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Records a timeline of Scheduler::execute runs as Chrome trace JSON, which
+ * chrome://tracing and Perfetto open directly.
+ *
+ * attach() observes a cell the same way CellProfiler does, sharing the
+ * profile flag with it: each process call becomes a complete event on the
+ * thread that ran it, spanning Cell::us[T_PROCESS] and tagged with the pid
+ * it was for, the attempt at that pid and its result. Observers are not
+ * told the pid or the return code, so both are read back from the tokens:
+ * a call that stamped a newer pid on the cell's outputs returned OK for it,
+ * any other call returned DO_OVER for the pid after the last one finished.
+ * A cell that finishes without writing any output therefore shows up as a
+ * retry. Counting restarts with every execute(), which wraps
+ * Scheduler::execute in a run span.
+ *
+ * Each thread appends to its own buffer, so recording takes no lock after
+ * a thread's first event. Call write() once the runs are finished.
+ */
+class TESTERCELL_API TraceRecorder
+{
+public:
+    TraceRecorder();
+    ~TraceRecorder();
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    void attach(const cell_ptr &cell);
+    void detach();
+
+    /** Runs sched.execute(n) inside a span named after the run. */
+    int execute(Scheduler &sched, int n);
+
+    void write(std::ostream &out) const;
+    /** Writes the trace to path, throws std::runtime_error on failure. */
+    void write(const std::string &path) const;
+private:
+    struct Event
+    {
+        std::int64_t ts, dur; //microseconds since the recorder was created
+        std::int32_t cell;    //-1 for an execute span
+        std::int32_t pid;     //the run for an execute span
+        std::int32_t attempt; //pids run for an execute span
+        std::int32_t ret;
+    };
+    struct ThreadBuffer
+    {
+        int tid;
+        std::vector<Event> events;
+    };
+    struct Probe;
+
+    ThreadBuffer& buffer();
+    void record(const Event &e);
+    std::int64_t now() const;
+
+    std::uint64_t id_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::vector<std::unique_ptr<Probe>> probes_;
+    mutable std::mutex mutex_; //guards buffers_ registration
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    int runs_;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_TRACE_H_ */
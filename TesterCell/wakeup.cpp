@@ -0,0 +1,36 @@
+/*
+ * wakeup.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/wakeup.h"
+
+#include <algorithm>
+
+namespace Quantum {
+namespace TesterCell {
+
+namespace
+{
+
+thread_local WakeTime posted = WakeTime::max();
+
+}//namespace
+
+void wake_at(WakeTime t)
+{
+    posted = std::min(posted, t);
+}
+
+WakeTime take_wake_time()
+{
+    WakeTime t = posted;
+    posted = WakeTime::max();
+    return t;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
@@ -0,0 +1,40 @@
+/*
+ * wakeup.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_WAKEUP_H_
+#define TESTERCELL_WAKEUP_H_
+
+#include "testercell_config.h"
+
+#include <chrono>
+
+namespace Quantum {
+namespace TesterCell {
+
+typedef std::chrono::steady_clock::time_point WakeTime;
+
+/**
+ * Timer wakeups for cells that wait by returning DO_OVER, such as Delay.
+ * Before returning DO_OVER the cell calls wake_at() with the time it will
+ * be ready, and the executor that ran it collects the deadline on the same
+ * thread with take_wake_time(). Once only such cells are left, the
+ * executors of this plugin sleep until the earliest deadline instead of
+ * polling. The engine's Scheduler ignores the deadlines.
+ */
+TESTERCELL_API void wake_at(WakeTime t);
+
+/**
+ * The earliest deadline posted on this thread since the last call, or
+ * WakeTime::max() if none was, and forgets it.
+ */
+TESTERCELL_API WakeTime take_wake_time();
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_WAKEUP_H_ */
@@ -0,0 +1,442 @@
+/*
+ * work_stealing.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#include "TesterCell/work_stealing.h"
+
+namespace Quantum {
+namespace TesterCell {
+
+const std::size_t WorkDeque::EMPTY;
+
+WorkDeque::WorkDeque(std::size_t capacity):
+        top_(0),
+        bottom_(0)
+{
+    std::size_t size = 1;
+    while(size < capacity + 1)
+    {
+        size <<= 1;
+    }
+    mask_ = size - 1;
+    items_.reset(new std::atomic<std::size_t>[size]);
+}
+
+void WorkDeque::push(std::size_t k)
+{
+    std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    items_[b & mask_].store(k, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+}
+
+std::size_t WorkDeque::pop()
+{
+    std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top_.load(std::memory_order_relaxed);
+    if(t > b)
+    {
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return EMPTY;
+    }
+    std::size_t k = items_[b & mask_].load(std::memory_order_relaxed);
+    if(t == b)
+    {
+        //last item, race the thieves for it
+        if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                std::memory_order_relaxed))
+        {
+            k = EMPTY;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return k;
+}
+
+std::size_t WorkDeque::steal()
+{
+    std::int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom_.load(std::memory_order_acquire);
+    if(t >= b)
+    {
+        return EMPTY;
+    }
+    std::size_t k = items_[t & mask_].load(std::memory_order_relaxed);
+    if(!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+            std::memory_order_relaxed))
+    {
+        return EMPTY;
+    }
+    return k;
+}
+
+WorkStealingExecutor::WorkStealingExecutor(const CircuitGraph &graph, unsigned threads):
+        graph_(graph),
+        flow_(graph, true),
+        stall_timeout_(std::chrono::milliseconds::zero()),
+        capacity_(graph.size()),
+        pending_(new std::atomic<std::size_t>[graph.size()]),
+        next_root_(0),
+        remaining_(0),
+        running_(0),
+        stopped_(false),
+        result_(Quantum::OK)
+{
+    graph.circuit()->configure_all();
+    if(!threads)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        if(!flow_.upstream(k) && flow_.cell(k))
+        {
+            roots_.push_back(k);
+        }
+    }
+    for(unsigned w = 0; w < threads; w++)
+    {
+        workers_.emplace_back(new Worker(capacity_));
+        workers_.back()->seed = 2654435761u * (w + 1);
+    }
+    for(unsigned w = 1; w < threads; w++)
+    {
+        threads_.emplace_back(&WorkStealingExecutor::pool, this, w);
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wake_.notify_all();
+    for(std::thread &t: threads_)
+    {
+        t.join();
+    }
+}
+
+ReturnCode WorkStealingExecutor::execute(int n)
+{
+    for(int pid = 0; pid < n; pid++)
+    {
+        if(between_pids_)
+        {
+            between_pids_(pid);
+        }
+        sync();
+        ReturnCode ret = execute_pid(pid);
+        if(ret != Quantum::OK)
+        {
+            return ret;
+        }
+    }
+    return Quantum::OK;
+}
+
+ExecutorStats WorkStealingExecutor::stats() const
+{
+    ExecutorStats s;
+    for(const std::unique_ptr<Worker> &w: workers_)
+    {
+        s.processed += w->processed;
+        s.retries += w->retries;
+    }
+    s.stalls = stalls_;
+    return s;
+}
+
+std::uint64_t WorkStealingExecutor::steals() const
+{
+    std::uint64_t n = 0;
+    for(const std::unique_ptr<Worker> &w: workers_)
+    {
+        n += w->steals;
+    }
+    return n;
+}
+
+ReturnCode WorkStealingExecutor::execute_pid(int pid)
+{
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        pending_[k].store(flow_.upstream(k), std::memory_order_relaxed);
+    }
+    next_root_.store(0, std::memory_order_relaxed);
+    remaining_.store(flow_.live(), std::memory_order_relaxed);
+    running_.store(0, std::memory_order_relaxed);
+    stopped_.store(false, std::memory_order_relaxed);
+    result_.store(Quantum::OK, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pid_ = pid;
+        epoch_++;
+        active_ = threads_.size();
+    }
+    wake_.notify_all();
+    work(0);
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this]{return active_ == 0;});
+    }
+
+    ReturnCode ret = ReturnCode(result_.load());
+    if(ret != Quantum::OK)
+    {
+        //a stopped pid leaves work behind, every worker is parked so the
+        //deques can be drained from here
+        for(std::unique_ptr<Worker> &w: workers_)
+        {
+            while(w->deque->pop() != WorkDeque::EMPTY)
+            {}
+            w->retry.clear();
+            w->wake = WakeTime::max();
+            w->untimed = false;
+        }
+    }
+    if(error_)
+    {
+        std::exception_ptr e = error_;
+        error_ = nullptr;
+        std::rethrow_exception(e);
+    }
+    return ret;
+}
+
+void WorkStealingExecutor::sync()
+{
+    if(!flow_.sync(graph_))
+    {
+        return;
+    }
+    //threads and their deques stay, only what depends on the topology is
+    //redone, deques are only replaced when the circuit outgrew them
+    if(flow_.size() > capacity_)
+    {
+        capacity_ = std::max(flow_.size(), capacity_ * 2);
+        pending_.reset(new std::atomic<std::size_t>[capacity_]);
+        for(std::unique_ptr<Worker> &w: workers_)
+        {
+            w->deque.reset(new WorkDeque(capacity_));
+        }
+    }
+    roots_.clear();
+    for(std::size_t k = 0; k < flow_.size(); k++)
+    {
+        if(!flow_.upstream(k) && flow_.cell(k))
+        {
+            roots_.push_back(k);
+        }
+    }
+}
+
+void WorkStealingExecutor::pool(std::size_t w)
+{
+    std::uint64_t seen = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]{return shutdown_ || epoch_ != seen;});
+            if(shutdown_)
+            {
+                return;
+            }
+            seen = epoch_;
+        }
+        work(w);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(--active_ == 0)
+        {
+            idle_.notify_one();
+        }
+    }
+}
+
+void WorkStealingExecutor::work(std::size_t w)
+{
+    typedef std::chrono::steady_clock clock;
+    Worker &self = *workers_[w];
+    std::size_t last = 0;
+    clock::time_point since = clock::now();
+    //stops the pid once nothing has finished anywhere for the stall timeout
+    //while every cell still being processed is a retry, a cell that is
+    //merely slow never stalls the pid; without a timeout it never stalls
+    auto stalled = [&]()
+    {
+        if(stall_timeout_.count() <= 0)
+        {
+            return false;
+        }
+        std::size_t r = remaining_.load(std::memory_order_relaxed);
+        if(r != last || running_.load(std::memory_order_relaxed))
+        {
+            last = r;
+            since = clock::now();
+            return false;
+        }
+        if(clock::now() - since <= stall_timeout_)
+        {
+            return false;
+        }
+        if(stop(Quantum::DO_OVER))
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            stalls_++;
+        }
+        return true;
+    };
+    take_wake_time();
+    while(remaining_.load(std::memory_order_acquire) && !stopped_.load(std::memory_order_relaxed))
+    {
+        std::size_t k = next(self);
+        if(k == WorkDeque::EMPTY)
+        {
+            if(stalled())
+            {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+
+        //pulled once per pid, a second move would swap the values back
+        bool retry = (k & RETRY) != 0;
+        if(retry)
+        {
+            k &= ~RETRY;
+        }
+        else
+        {
+            flow_.pull(k);
+            running_.fetch_add(1, std::memory_order_relaxed);
+        }
+        ReturnCode ret;
+        try
+        {
+            ret = flow_.cell(k)->process(pid_);
+            if(!retry)
+            {
+                running_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if(!error_)
+            {
+                error_ = std::current_exception();
+            }
+            stop(Quantum::UNKNOWN);
+            break;
+        }
+        self.processed++;
+        if(ret == Quantum::DO_OVER)
+        {
+            self.retries++;
+            self.retry.push_back(k | RETRY);
+            WakeTime t = take_wake_time();
+            self.untimed = self.untimed || t == WakeTime::max();
+            self.wake = std::min(self.wake, t);
+            if(stalled())
+            {
+                break;
+            }
+            continue;
+        }
+        if(ret != Quantum::OK)
+        {
+            stop(ret);
+            break;
+        }
+        for(std::size_t down: flow_.dependents(k))
+        {
+            if(pending_[down].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                self.deque->push(down);
+            }
+        }
+        remaining_.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+std::size_t WorkStealingExecutor::next(Worker &self)
+{
+    std::size_t k = self.deque->pop();
+    if(k != WorkDeque::EMPTY)
+    {
+        return k;
+    }
+    if(next_root_.load(std::memory_order_relaxed) < roots_.size())
+    {
+        std::size_t r = next_root_.fetch_add(1, std::memory_order_relaxed);
+        if(r < roots_.size())
+        {
+            return roots_[r];
+        }
+    }
+    std::size_t n = workers_.size();
+    for(std::size_t attempt = 1; attempt < n; attempt++)
+    {
+        //xorshift, victims picked at random so thieves spread out
+        self.seed ^= self.seed << 13;
+        self.seed ^= self.seed >> 17;
+        self.seed ^= self.seed << 5;
+        Worker &victim = *workers_[self.seed % n];
+        if(&victim == &self)
+        {
+            continue;
+        }
+        k = victim.deque->steal();
+        if(k != WorkDeque::EMPTY)
+        {
+            self.steals++;
+            return k;
+        }
+    }
+    //only cells that asked to be run again are left here, hand them back
+    //to the deque where idle workers can pick them up too; while they all
+    //wait on timers, sleep towards the first deadline but look for stolen
+    //work again within a millisecond
+    if(!self.retry.empty())
+    {
+        if(self.untimed || self.wake == WakeTime::max())
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_until(std::min(self.wake,
+                    std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+        }
+        self.wake = WakeTime::max();
+        self.untimed = false;
+        for(std::size_t r: self.retry)
+        {
+            self.deque->push(r);
+        }
+        self.retry.clear();
+        return self.deque->pop();
+    }
+    return WorkDeque::EMPTY;
+}
+
+bool WorkStealingExecutor::stop(ReturnCode ret)
+{
+    int ok = Quantum::OK;
+    bool first = result_.compare_exchange_strong(ok, ret);
+    stopped_.store(true, std::memory_order_relaxed);
+    return first;
+}
+
+}//namespace TesterCell
+}//namespace Quantum
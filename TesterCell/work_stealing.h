@@ -0,0 +1,145 @@
+/*
+ * work_stealing.h
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTERCELL_WORK_STEALING_H_
+#define TESTERCELL_WORK_STEALING_H_
+
+#include "TesterCell/dataflow.h"
+#include "TesterCell/wakeup.h"
+
+#include <atomic>
+#include <cstdint>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * Fixed capacity Chase-Lev deque of cell indices. The owning worker pushes
+ * and pops at the bottom, any other worker steals from the top, none of
+ * them takes a lock.
+ */
+class TESTERCELL_API WorkDeque
+{
+public:
+    static const std::size_t EMPTY = static_cast<std::size_t>(-1);
+
+    explicit WorkDeque(std::size_t capacity);
+
+    /** Owner only. The deque must not already hold capacity items. */
+    void push(std::size_t k);
+    /** Owner only. Returns EMPTY if there is nothing left. */
+    std::size_t pop();
+    /** Any thread. Returns EMPTY if the deque is empty or the race was lost. */
+    std::size_t steal();
+private:
+    std::size_t mask_;
+    std::unique_ptr<std::atomic<std::size_t>[]> items_;
+    //owner and thieves write different ends, keep them on their own lines
+    std::atomic<std::int64_t> top_;
+    char pad_[64 - sizeof(std::atomic<std::int64_t>)];
+    std::atomic<std::int64_t> bottom_;
+};
+
+/**
+ * DataflowExecutor spread over a pool of threads. Each worker runs the
+ * cells it woke up from its own deque and steals from a random victim when
+ * that runs dry, so independent branches of a circuit keep every worker
+ * busy without a shared queue.
+ *
+ * The calling thread is worker 0, threads - 1 more are started with the
+ * executor and parked between pids. Exceptions thrown by a cell are
+ * rethrown from execute() once all workers have stopped.
+ *
+ * Like DataflowExecutor, edits to the graph are applied before each pid
+ * while the pool keeps running, and pids are only abandoned once
+ * stall_timeout() is set. The graph must outlive the executor.
+ */
+class TESTERCELL_API WorkStealingExecutor
+{
+public:
+    WorkStealingExecutor(const CircuitGraph &graph, unsigned threads);
+    ~WorkStealingExecutor();
+
+    /** Processes pids 0 to n-1. */
+    ReturnCode execute(int n);
+
+    /** Called with the pid about to run, the place to edit the graph. */
+    void between_pids(std::function<void(int)> hook) {between_pids_ = std::move(hook);}
+    /** See Dataflow::move_single_consumer. */
+    void move_single_consumer(bool on) {flow_.move_single_consumer(on);}
+    /** See DataflowExecutor::stall_timeout. */
+    void stall_timeout(std::chrono::milliseconds timeout) {stall_timeout_ = timeout;}
+    unsigned threads() const {return static_cast<unsigned>(workers_.size());}
+    ExecutorStats stats() const;
+    /** Cells taken from another worker's deque. */
+    std::uint64_t steals() const;
+    const Dataflow& dataflow() const {return flow_;}
+private:
+    struct Worker
+    {
+        explicit Worker(std::size_t capacity): deque(new WorkDeque(capacity)) {}
+        std::unique_ptr<WorkDeque> deque;
+        std::vector<std::size_t> retry; //cells that returned DO_OVER, tagged RETRY
+        WakeTime wake = WakeTime::max(); //earliest deadline posted by retry
+        bool untimed = false;            //a cell in retry posted none
+        std::uint64_t processed = 0, retries = 0, steals = 0;
+        unsigned seed = 0;
+        char pad[64];
+    };
+
+    //tags a cell queued again after DO_OVER, its inputs are already pulled
+    static const std::size_t RETRY = ~(WorkDeque::EMPTY >> 1);
+
+    ReturnCode execute_pid(int pid);
+    /** Follows edits to the graph, only while the pool is parked. */
+    void sync();
+    void pool(std::size_t w);
+    void work(std::size_t w);
+    std::size_t next(Worker &self);
+    /** Ends the pid, returns true for the worker whose code is kept. */
+    bool stop(ReturnCode ret);
+
+    const CircuitGraph &graph_;
+    std::function<void(int)> between_pids_;
+    Dataflow flow_;
+    std::chrono::milliseconds stall_timeout_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::size_t capacity_;
+    std::vector<std::thread> threads_;
+    std::vector<std::size_t> roots_;
+    std::unique_ptr<std::atomic<std::size_t>[]> pending_;
+    std::uint64_t stalls_ = 0;
+
+    //state of the pid being run
+    int pid_ = 0;
+    std::atomic<std::size_t> next_root_;
+    std::atomic<std::size_t> remaining_;
+    std::atomic<std::size_t> running_; //cells in process() for the first time
+    std::atomic<bool> stopped_;
+    std::atomic<int> result_;
+    std::exception_ptr error_;
+    std::mutex error_mutex_;
+
+    //pool hand-off
+    std::mutex mutex_;
+    std::condition_variable wake_, idle_;
+    std::uint64_t epoch_ = 0;
+    std::size_t active_ = 0;
+    bool shutdown_ = false;
+};
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#endif /* TESTERCELL_WORK_STEALING_H_ */
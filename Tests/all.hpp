@@ -10,16 +10,34 @@
 #ifndef TESTS_ALL_HPP_
 #define TESTS_ALL_HPP_
 
-#include "tests/test_signals.hpp"
-#include "tests/test_clone.hpp"
-#include "tests/test_exceptions.hpp"
-#include "tests/test_profiling.hpp"
-#include "tests/test_behaviors.hpp"
-#include "tests/test_cellsocket.hpp"
-#include "tests/test_cellsockets.hpp"
-#include "tests/test_static.hpp"
-#include "tests/test_sockethandle.hpp"
-#include "tests/test_scheduler.hpp"
-#include "tests/test_circuit.hpp"
+#include "Tests/test_signals.hpp"
+#include "Tests/test_clone.hpp"
+#include "Tests/test_exceptions.hpp"
+#include "Tests/test_profiling.hpp"
+#include "Tests/test_behaviors.hpp"
+#include "Tests/test_cellsocket.hpp"
+#include "Tests/test_cellsockets.hpp"
+#include "Tests/test_static.hpp"
+#include "Tests/test_sockethandle.hpp"
+#include "Tests/test_scheduler.hpp"
+#include "Tests/test_circuit.hpp"
+#include "Tests/test_generator.hpp"
+#include "Tests/test_batch.hpp"
+#include "Tests/test_async_writer.hpp"
+#include "Tests/test_format.hpp"
+#include "Tests/test_trace.hpp"
+#include "Tests/test_dataflow.hpp"
+#include "Tests/test_work_stealing.hpp"
+#include "Tests/test_pipeline.hpp"
+#include "Tests/test_incremental.hpp"
+#include "Tests/test_editing.hpp"
+#include "Tests/test_frozen.hpp"
+#include "Tests/test_fusion.hpp"
+#include "Tests/test_move.hpp"
+#include "Tests/test_shared.hpp"
+#include "Tests/test_socket_keys.hpp"
+#include "Tests/test_arena.hpp"
+#include "Tests/test_pool.hpp"
+#include "Tests/test_plugin.hpp"
 
 #endif /* TESTS_ALL_HPP_ */
@@ -11,6 +11,9 @@
 #define TESTS_CELLS_HPP_
 
 #include "Engine/all.hpp"
+#include "TesterCell/circuit_graph.h"
+#include "TesterCell/wakeup.h"
+#include "gtest/gtest.h"
 
 #include <chrono>
 #include <thread>
@@ -88,6 +91,56 @@ struct Pause
     }
 };
 
+/**
+ * Like Pause, but never sleeps on the scheduler thread. The first call arms
+ * a deadline and returns DO_OVER, later calls return DO_OVER until the
+ * deadline has passed, so any number of concurrent delays share the
+ * scheduler's worker threads.
+ *
+ * Every DO_OVER posts the deadline with TesterCell::wake_at(), so the
+ * plugin's executors sleep until the first delay is due once only delays
+ * are left. The engine's Scheduler polls a waiting delay in a loop instead,
+ * so each of its threads that has nothing but delays left burns a full
+ * core until the deadline.
+ */
+struct Delay
+{
+    static void declare_io(const CellSockets &p, CellSockets &i, CellSockets &o)
+    {
+        i.declare<int>("milliseconds", "Number of milliseconds to delay", 0);
+        i.declare<bool>("link", "Connection to prior node", false);
+        i["link"]->required(true);
+        o.declare<bool>("done", "Connector to next node", false);
+    }
+
+    ReturnCode process(const CellSockets &i, const CellSockets &o)
+    {
+        typedef std::chrono::steady_clock clock;
+        if(!armed)
+        {
+            int ms = i.get<int>("milliseconds");
+            if(ms > 0)
+            {
+                wake = clock::now() + std::chrono::milliseconds(ms);
+                armed = true;
+                TesterCell::wake_at(wake);
+                return Quantum::DO_OVER;
+            }
+        }
+        else if(clock::now() < wake)
+        {
+            TesterCell::wake_at(wake);
+            return Quantum::DO_OVER;
+        }
+        armed = false;
+        o["done"] << true;
+        return Quantum::OK;
+    }
+
+    bool armed = false;
+    std::chrono::steady_clock::time_point wake;
+};
+
 struct A
 {
     static void
@@ -327,6 +380,100 @@ struct Add
     Quantum::SocketHandle<double> out_, left_, right_;
 };
 
+/**
+ * Outputs 1, 2, 3 ... on successive calls.
+ */
+struct Counter
+{
+    static void declare_io(const Quantum::CellSockets& p, Quantum::CellSockets& i, Quantum::CellSockets& o)
+    {
+        o.declare(&Counter::count_,"count");
+    }
+    int process(const CellSockets& i, const CellSockets& o)
+    {
+        *count_ += 1.0;
+        return Quantum::OK;
+    }
+    Quantum::SocketHandle<double> count_;
+};
+
+/**
+ * Running total of every value it has been given.
+ */
+struct Sum
+{
+    static void declare_io(const Quantum::CellSockets& p, Quantum::CellSockets& i, Quantum::CellSockets& o)
+    {
+        i.declare(&Sum::value_,"value");
+        o.declare(&Sum::total_,"total");
+    }
+    int process(const CellSockets& i, const CellSockets& o)
+    {
+        *total_ += *value_;
+        return Quantum::OK;
+    }
+    Quantum::SocketHandle<double> value_, total_;
+};
+
+/**
+ * Outputs the first element of its input batch, read through a const
+ * View& so a wrapped batch such as a SharedBatch is never copied.
+ */
+template<typename In, typename View = In>
+struct Front
+{
+    static void declare_io(const Quantum::CellSockets& p, Quantum::CellSockets& i, Quantum::CellSockets& o)
+    {
+        i.declare(&Front::in_,"in");
+        o.declare(&Front::out_,"out");
+    }
+    int process(const CellSockets& i, const CellSockets& o)
+    {
+        const View &batch = *in_;
+        *out_ = batch.empty() ? 0.0 : batch.front();
+        return Quantum::OK;
+    }
+    Quantum::SocketHandle<In> in_;
+    Quantum::SocketHandle<double> out_;
+};
+
+/**
+ * Front that returns DO_OVER "retries" times on every pid before it reads
+ * its input, so its executor retries it on the same pulled value.
+ */
+template<typename In>
+struct Reluctant
+{
+    static void declare_params(Quantum::CellSockets& p)
+    {
+        p.declare<int>("retries", "DO_OVER returns before each output", 1);
+    }
+    static void declare_io(const Quantum::CellSockets& p, Quantum::CellSockets& i, Quantum::CellSockets& o)
+    {
+        i.declare(&Reluctant::in_,"in");
+        o.declare(&Reluctant::out_,"out");
+    }
+    void configure(const CellSockets& p, const CellSockets& i, const CellSockets& o)
+    {
+        retries_ = p["retries"];
+    }
+    int process(const CellSockets& i, const CellSockets& o)
+    {
+        if(refused < *retries_)
+        {
+            refused++;
+            return Quantum::DO_OVER;
+        }
+        refused = 0;
+        *out_ = in_->empty() ? 0.0 : in_->front();
+        return Quantum::OK;
+    }
+    int refused = 0;
+    Quantum::SocketHandle<int> retries_;
+    Quantum::SocketHandle<In> in_;
+    Quantum::SocketHandle<double> out_;
+};
+
 struct PyTest
 {
     static void declare_io(const Quantum::CellSockets& p, Quantum::CellSockets& i, Quantum::CellSockets& o)
@@ -347,6 +494,27 @@ struct PyTest
     SocketHandle<bp::dict> in_, out_;
 };
 
+/**
+ * Builds the graph twice with build(graph), runs one copy with
+ * exec(graph, n) and the other with the Scheduler, then expects every cell
+ * to end with the same double "out" and the same token.
+ */
+template<typename Build, typename Exec>
+void expect_same_as_scheduler(Build build, Exec exec, int n)
+{
+    TesterCell::CircuitGraph g, reference;
+    build(g);
+    build(reference);
+    EXPECT_EQ(Quantum::OK, exec(g, n));
+    EXPECT_EQ(Quantum::OK, Scheduler(reference.circuit()).execute(n));
+    ASSERT_EQ(reference.size(), g.size());
+    for(std::size_t k = 0; k < g.size(); k++)
+    {
+        EXPECT_EQ(reference[k]->outputs.get<double>("out"), g[k]->outputs.get<double>("out"));
+        EXPECT_EQ(reference[k]->outputs["out"]->token_id(), g[k]->outputs["out"]->token_id());
+    }
+}
+
 }//Quantum namespace
 
 
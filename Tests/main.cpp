@@ -0,0 +1,17 @@
+/*
+ * main.cpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ *
+ * Usage: TesterCellTests [--gtest_filter=Scheduler.*]
+ */
+
+#include "Tests/all.hpp"
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
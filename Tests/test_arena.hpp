@@ -0,0 +1,83 @@
+/*
+ * test_arena.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_ARENA_HPP_
+#define TESTS_TEST_ARENA_HPP_
+
+#include "Engine/all.hpp"
+#include "cells.hpp"
+#include "TesterCell/arena.h"
+#include "TesterCell/generator.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Arena, Cells_keep_their_arena)
+{
+    std::weak_ptr<TesterCell::CellArena> weak;
+    cell_ptr add;
+    {
+        TesterCell::arena_ptr arena = std::make_shared<TesterCell::CellArena>(4096);
+        weak = arena;
+        add = TesterCell::make_cell<Add>(arena);
+        EXPECT_GT(arena->used(), 0u);
+        for(int k = 0; k < 100; k++)
+        {
+            TesterCell::make_cell<Add>(arena); //released at once, memory stays
+        }
+        EXPECT_GT(arena->reserved(), 4096u);
+    }
+    EXPECT_FALSE(weak.expired());
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 2.0;
+    add->configure();
+    EXPECT_EQ(Quantum::OK, add->process());
+    EXPECT_EQ(3.0, add->outputs.get<double>("out"));
+    add.reset();
+    EXPECT_TRUE(weak.expired());
+}
+
+TEST(Arena, Same_circuit_as_clones)
+{
+    TesterCell::GeneratorOptions opts;
+    opts.seed = 3;
+    opts.cells = 300;
+    opts.fan_in = 1.5;
+    opts.mix.pause = 0;
+    opts.mix.branch = 0;
+    opts.mix.print = 0;
+    TesterCell::circuit_graph_ptr heap = TesterCell::CircuitGenerator(opts).generate();
+    opts.arena = std::make_shared<TesterCell::CellArena>();
+    TesterCell::circuit_graph_ptr arena = TesterCell::CircuitGenerator(opts).generate();
+    ASSERT_EQ(heap->connections().size(), arena->connections().size());
+    for(std::size_t k = 0; k < heap->connections().size(); k++)
+    {
+        EXPECT_EQ(heap->connections()[k].from, arena->connections()[k].from);
+        EXPECT_EQ(heap->connections()[k].to, arena->connections()[k].to);
+    }
+
+    Scheduler(heap->circuit()).execute(2);
+    Scheduler(arena->circuit()).execute(2);
+    for(std::size_t k = 0; k < heap->size(); k++)
+    {
+        //only Add and Operation, whose single output is out or ans
+        if((*heap)[k]->outputs.count("out"))
+        {
+            EXPECT_EQ((*heap)[k]->outputs.get<double>("out"), (*arena)[k]->outputs.get<double>("out"));
+        }
+        else
+        {
+            EXPECT_EQ((*heap)[k]->outputs.get<int>("ans"), (*arena)[k]->outputs.get<int>("ans"));
+        }
+    }
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_ARENA_HPP_ */
@@ -0,0 +1,128 @@
+/*
+ * test_async_writer.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_ASYNC_WRITER_HPP_
+#define TESTS_TEST_ASYNC_WRITER_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/async_writer.h"
+#include "TesterCell/tester.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <unistd.h>
+
+namespace Quantum
+{
+
+TEST(AsyncWriter, Batches_and_drops)
+{
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    {
+        //the writer thread won't wake up on its own during this test
+        TesterCell::AsyncWriter w(fds[1], 4, 1 << 20, std::chrono::hours(1));
+        for(int k = 0; k < 7; k++)
+        {
+            w.write("m" + std::to_string(k) + "\n");
+        }
+        //the ring only holds 4 messages
+        EXPECT_EQ(3u, w.dropped());
+        EXPECT_EQ(0u, w.written());
+
+        w.flush();
+        EXPECT_EQ(4u, w.written());
+        EXPECT_EQ(1u, w.writes()); //one write(2) for the whole batch
+        char buf[64] = {0};
+        ASSERT_EQ(12, read(fds[0], buf, sizeof(buf) - 1));
+        EXPECT_EQ(std::string("m0\nm1\nm2\nm3\n"), buf);
+    }
+    {
+        //the byte budget is enforced as well
+        TesterCell::AsyncWriter w(fds[1], 64, 8, std::chrono::hours(1));
+        EXPECT_TRUE(w.write("12345"));
+        EXPECT_FALSE(w.write("6789"));
+        EXPECT_EQ(1u, w.dropped());
+    }//destruction flushes what is left
+    char buf[64] = {0};
+    ASSERT_EQ(5, read(fds[0], buf, sizeof(buf) - 1));
+    EXPECT_EQ(std::string("12345"), buf);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(AsyncWriter, Many_producers)
+{
+    FILE *f = tmpfile();
+    ASSERT_TRUE(f != nullptr);
+    {
+        TesterCell::AsyncWriter w(fileno(f), 1024, 1 << 20,
+                std::chrono::milliseconds(1));
+        std::vector<std::thread> producers;
+        for(int t = 0; t < 8; t++)
+        {
+            producers.emplace_back([&w](){
+                for(int k = 0; k < 10000; k++)
+                {
+                    while(!w.write("x\n"))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for(std::thread &t: producers)
+        {
+            t.join();
+        }
+        w.flush();
+        EXPECT_EQ(80000u, w.written());
+        EXPECT_LT(w.writes(), 80000u);
+    }
+    EXPECT_EQ(160000, lseek(fileno(f), 0, SEEK_END));
+    fclose(f);
+}
+
+TEST(AsyncWriter, Buffered_print)
+{
+    cell_ptr print = std::make_shared<Cell_<TesterCell::Print>>();
+    print->declare_params();
+    print->declare_io();
+    print->parameters["buffered"] << true;
+    print->configure();
+    print->inputs[">>"] << Quantum::OK;
+    print->inputs["msg"] << std::string("Buffered hello");
+
+    TesterCell::AsyncWriter &out = TesterCell::AsyncWriter::standard_output();
+    std::uint64_t before = out.written() + out.dropped();
+    EXPECT_EQ(Quantum::OK, print->process());
+    EXPECT_EQ(Quantum::OK, print->outputs.get<ReturnCode>(">>"));
+    out.flush();
+    EXPECT_EQ(before + 1, out.written() + out.dropped());
+    //configuring a cell leaves the process wide writer alone
+    EXPECT_EQ(std::chrono::milliseconds(10), out.flush_interval());
+}
+
+TEST(AsyncWriter, Interval_is_at_least_a_millisecond)
+{
+    FILE *f = tmpfile();
+    ASSERT_TRUE(f != nullptr);
+    {
+        TesterCell::AsyncWriter w(fileno(f), 16, 1 << 20, std::chrono::milliseconds(0));
+        EXPECT_EQ(std::chrono::milliseconds(1), w.flush_interval());
+        w.flush_interval(std::chrono::milliseconds(-5));
+        EXPECT_EQ(std::chrono::milliseconds(1), w.flush_interval());
+        w.flush_interval(std::chrono::milliseconds(20));
+        EXPECT_EQ(std::chrono::milliseconds(20), w.flush_interval());
+    }
+    fclose(f);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_ASYNC_WRITER_HPP_ */
@@ -0,0 +1,93 @@
+/*
+ * test_batch.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_BATCH_HPP_
+#define TESTS_TEST_BATCH_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/batch.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Batch, Kernels_match_scalar)
+{
+    //odd lengths exercise the scalar tail after the vector loop
+    for(std::size_t n = 0; n < 11; n++)
+    {
+        TesterCell::Batch a(n), b(n), c(n), out(n);
+        for(std::size_t k = 0; k < n; k++)
+        {
+            a[k] = k + 0.5;
+            b[k] = 2.0 * k - 3.0;
+            c[k] = 0.25 * k;
+        }
+        TesterCell::kernels::add(a.data(), b.data(), out.data(), n);
+        for(std::size_t k = 0; k < n; k++) EXPECT_EQ(a[k] + b[k], out[k]);
+        TesterCell::kernels::subtract(a.data(), b.data(), out.data(), n);
+        for(std::size_t k = 0; k < n; k++) EXPECT_EQ(a[k] - b[k], out[k]);
+        TesterCell::kernels::multiply_add(a.data(), b.data(), c.data(), out.data(), n);
+        for(std::size_t k = 0; k < n; k++) EXPECT_DOUBLE_EQ(a[k] * b[k] + c[k], out[k]);
+    }
+}
+
+TEST(Batch, Cells)
+{
+    cell_ptr add = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << TesterCell::Batch{1, 2, 3, 4, 5};
+    add->inputs["right"] << TesterCell::Batch{5, 4, 3, 2, 1};
+    add->process();
+    EXPECT_EQ(TesterCell::Batch(5, 6.0), add->outputs.get<TesterCell::Batch>("out"));
+
+    cell_ptr op = std::make_shared<Cell_<TesterCell::BatchOperation>>();
+    op->declare_params();
+    op->declare_io();
+    op->parameters["minus"] << true;
+    op->configure();
+    op->inputs["a"] << TesterCell::Batch{1, 2, 3};
+    op->inputs["b"] << TesterCell::Batch{1, 1, 1};
+    op->process();
+    EXPECT_EQ((TesterCell::Batch{0, 1, 2}), op->outputs.get<TesterCell::Batch>("ans"));
+
+    //batches of different sizes cannot be combined
+    op->inputs["b"] << TesterCell::Batch{1, 1};
+    EXPECT_THROW(op->process(), std::runtime_error);
+
+    cell_ptr fma = std::make_shared<Cell_<TesterCell::BatchMultiplyAdd>>();
+    fma->declare_params();
+    fma->declare_io();
+    fma->inputs["a"] << TesterCell::Batch{1, 2};
+    fma->inputs["b"] << TesterCell::Batch{3, 4};
+    fma->inputs["c"] << TesterCell::Batch{0.5, 0.5};
+    fma->process();
+    EXPECT_EQ((TesterCell::Batch{3.5, 8.5}), fma->outputs.get<TesterCell::Batch>("out"));
+}
+
+TEST(Batch, Chained_in_circuit)
+{
+    cell_ptr a1 = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    a1->declare_params();
+    a1->declare_io();
+    cell_ptr a2 = a1->clone();
+    a1->inputs["left"] << TesterCell::Batch(1000, 1.0);
+    a1->inputs["right"] << TesterCell::Batch(1000, 2.0);
+    a2->inputs["right"] << TesterCell::Batch(1000, 3.0);
+    circuit_ptr c(new Circuit);
+    c->insert(a1);
+    c->insert(a2);
+    c->connect(a1, "out", a2, "left");
+    Scheduler(c).execute(1);
+    EXPECT_EQ(TesterCell::Batch(1000, 6.0), a2->outputs.get<TesterCell::Batch>("out"));
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_BATCH_HPP_ */
@@ -14,6 +14,15 @@
 #include "Engine/kernel.h"
 #include "cells.hpp"
 #include "gtest/gtest.h"
+#include "testercell.h"
+
+//set by the build to the engine root and the plugin it just built
+#ifndef TESTERCELL_ROOT_DIR
+  #define TESTERCELL_ROOT_DIR "/Users/Thomas/Quantum/QuantumGUI/src"
+#endif
+#ifndef TESTERCELL_PLUGIN
+  #define TESTERCELL_PLUGIN "libTesterCell.dylib"
+#endif
 
 namespace Quantum
 {
@@ -27,8 +36,12 @@ public:
     {
         theKernel = Kernel::getKernel();
         root_dir = "../../";
-        theKernel->setRootDirectory("/Users/Thomas/Quantum/QuantumGUI/src");
-        theKernel->loadPlugin("libTesterCell.dylib");
+        theKernel->setRootDirectory(TESTERCELL_ROOT_DIR);
+#if defined(TESTERCELLPLUGIN_STATICLIB)
+        TesterCell::register_cells(*theKernel);
+#else
+        theKernel->loadPlugin(TESTERCELL_PLUGIN);
+#endif
     }
 };
 
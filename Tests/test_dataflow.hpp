@@ -0,0 +1,134 @@
+/*
+ * test_dataflow.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_DATAFLOW_HPP_
+#define TESTS_TEST_DATAFLOW_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/dataflow.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <ctime>
+
+namespace Quantum
+{
+
+TEST(Dataflow, Same_result_as_scheduler)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+
+    //a diamond, built once for each executor
+    auto diamond = [&](TesterCell::CircuitGraph &g)
+    {
+        std::size_t top = g.insert(add->clone());
+        std::size_t l = g.insert(add->clone());
+        std::size_t r = g.insert(add->clone());
+        std::size_t bottom = g.insert(add->clone());
+        g.connect(top, "out", l, "left");
+        g.connect(top, "out", r, "left");
+        g.connect(l, "out", bottom, "left");
+        g.connect(r, "out", bottom, "right");
+    };
+    expect_same_as_scheduler(diamond, [](TesterCell::CircuitGraph &g, int n)
+    {
+        const std::size_t l = 1, bottom = 3; //in insertion order
+        TesterCell::DataflowExecutor exec(g);
+        EXPECT_EQ(1u, exec.dataflow().upstream(l));
+        EXPECT_EQ(2u, exec.dataflow().upstream(bottom));
+        ReturnCode ret = exec.execute(n);
+        EXPECT_EQ(6.0, g[bottom]->outputs.get<double>("out"));
+        EXPECT_EQ(2, g[bottom]->outputs["out"]->token_id());
+        //one call per cell and pid, nothing polled
+        EXPECT_EQ(12u, exec.stats().processed);
+        EXPECT_EQ(0u, exec.stats().retries);
+        return ret;
+    }, 3);
+}
+
+TEST(Dataflow, Parked_until_upstream_publishes)
+{
+    cell_ptr delay = std::make_shared<Cell_<Delay>>();
+    delay->declare_params();
+    delay->declare_io();
+    delay->inputs["milliseconds"] << 20;
+    cell_ptr pause = std::make_shared<Cell_<Pause>>();
+    pause->declare_params();
+    pause->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t head = g.insert(delay);
+    std::size_t prev = head;
+    for(int k = 0; k < 100; k++)
+    {
+        std::size_t next = g.insert(pause->clone());
+        g.connect(prev, "done", next, "link");
+        prev = next;
+    }
+
+    TesterCell::DataflowExecutor exec(g);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Quantum::OK, exec.execute(2));
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(ms, 40);
+    //only the delay itself is retried, the chain behind it is never polled
+    EXPECT_EQ(202u + exec.stats().retries, exec.stats().processed);
+    EXPECT_EQ(1, g[prev]->outputs["done"]->token_id());
+}
+
+TEST(Dataflow, Delays_sleep_until_due)
+{
+    cell_ptr delay = std::make_shared<Cell_<Delay>>();
+    delay->declare_params();
+    delay->declare_io();
+    delay->inputs["milliseconds"] << 100;
+
+    TesterCell::CircuitGraph g;
+    for(int k = 0; k < 1000; k++)
+    {
+        g.insert(delay->clone());
+    }
+    TesterCell::DataflowExecutor exec(g);
+    auto start = std::chrono::steady_clock::now();
+    std::clock_t cpu = std::clock();
+    EXPECT_EQ(Quantum::OK, exec.execute(1));
+    double cpu_ms = 1000.0 * (std::clock() - cpu) / CLOCKS_PER_SEC;
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+    //all delays wait together, and the thread sleeps instead of polling
+    EXPECT_GE(ms, 100);
+    EXPECT_LT(ms, 200);
+    EXPECT_LT(cpu_ms, 50.0);
+    EXPECT_LT(exec.stats().retries, 5000u);
+}
+
+TEST(Dataflow, Stall_is_abandoned)
+{
+    cell_ptr blocker = std::make_shared<Cell_<Delay>>();
+    blocker->declare_params();
+    blocker->declare_io();
+    blocker->inputs["milliseconds"] << 60000;
+
+    TesterCell::CircuitGraph g;
+    g.insert(blocker);
+    TesterCell::DataflowExecutor exec(g);
+    exec.stall_timeout(std::chrono::milliseconds(20));
+    EXPECT_EQ(Quantum::DO_OVER, exec.execute(10));
+    EXPECT_EQ(1u, exec.stats().stalls);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_DATAFLOW_HPP_ */
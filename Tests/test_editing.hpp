@@ -0,0 +1,176 @@
+/*
+ * test_editing.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_EDITING_HPP_
+#define TESTS_TEST_EDITING_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/dataflow.h"
+#include "TesterCell/work_stealing.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+#include <type_traits>
+
+namespace Quantum
+{
+
+TEST(Editing, Same_executor_after_edit)
+{
+    //Scheduler.Circuit_editing, without building a second executor
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t s1 = g.insert(sleeper->clone());
+    std::size_t s2 = g.insert(sleeper->clone());
+    g.connect(s1, "done", s2, "link");
+    TesterCell::DataflowExecutor exec(g);
+    EXPECT_EQ(Quantum::OK, exec.execute(1));
+    EXPECT_TRUE(g[s2]->outputs.get<bool>("done"));
+
+    g.remove(s2);
+    EXPECT_FALSE(g.contains(s2));
+    EXPECT_THROW(g.connect(s1, "done", s2, "link"), std::runtime_error);
+    std::size_t s3 = g.insert(sleeper->clone());
+    g.connect(s1, "done", s3, "link");
+    EXPECT_EQ(Quantum::OK, exec.execute(1));
+    EXPECT_TRUE(g[s3]->outputs.get<bool>("done"));
+    EXPECT_EQ(2u, exec.dataflow().live());
+    EXPECT_EQ(4u, exec.stats().processed);
+}
+
+TEST(Editing, Between_pids_of_a_running_execution)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    std::size_t b = g.insert(add->clone());
+    g.connect(a, "out", b, "left");
+
+    std::size_t c = 0;
+    TesterCell::WorkStealingExecutor exec(g, 2);
+    exec.between_pids([&](int pid)
+    {
+        if(pid == 5)
+        {
+            c = g.insert(add->clone());
+            g.connect(b, "out", c, "left");
+            g.disconnect(a, "out", b, "left");
+        }
+    });
+    EXPECT_EQ(Quantum::OK, exec.execute(10));
+    EXPECT_EQ(2u * 5 + 3u * 5, exec.stats().processed);
+    EXPECT_EQ(9, g[c]->outputs["out"]->token_id());
+    //b lost its upstream at pid 5 and runs on its own
+    EXPECT_EQ(0u, exec.dataflow().upstream(b));
+    EXPECT_EQ(1u, exec.dataflow().upstream(c));
+}
+
+TEST(Editing, Parallel_connections_keep_the_dependency)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    std::size_t b = g.insert(add->clone());
+    TesterCell::Dataflow flow(g, true);
+    g.connect(a, "out", b, "left");
+    g.connect(a, "out", b, "right");
+    EXPECT_TRUE(flow.sync(g));
+    EXPECT_FALSE(flow.sync(g));
+    EXPECT_EQ(1u, flow.upstream(b));
+    EXPECT_EQ(2u, flow.links(b).size());
+
+    g.disconnect(a, "out", b, "left");
+    flow.sync(g);
+    EXPECT_EQ(1u, flow.upstream(b));
+    g.disconnect(a, "out", b, "right");
+    flow.sync(g);
+    EXPECT_EQ(0u, flow.upstream(b));
+    EXPECT_TRUE(flow.dependents(a).empty());
+    EXPECT_THROW(g.disconnect(a, "out", b, "right"), std::runtime_error);
+
+    TesterCell::CircuitGraph untracked;
+    untracked.insert(add->clone());
+    EXPECT_THROW(untracked.edits_since(0), std::runtime_error);
+}
+
+TEST(Editing, Graph_is_not_copied_and_cells_are_inserted_once)
+{
+    //followers point at the graph, a copy would leave them on the original
+    static_assert(!std::is_copy_constructible<TesterCell::CircuitGraph>::value,
+            "CircuitGraph must not be copied");
+    static_assert(!std::is_copy_assignable<TesterCell::CircuitGraph>::value,
+            "CircuitGraph must not be copied");
+
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    TesterCell::CircuitGraph g;
+    TesterCell::Dataflow flow(g, true);
+    std::size_t a = g.insert(add);
+    EXPECT_THROW(g.insert(add), std::runtime_error);
+    EXPECT_EQ(1u, g.size());
+    EXPECT_EQ(1u, g.journaled());
+    //once removed it may come back, under a new index
+    g.remove(a);
+    EXPECT_EQ(1u, g.insert(add));
+}
+
+TEST(Editing, Journal_is_trimmed)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    {
+        //executors that do not sync never start the journal
+        TesterCell::Dataflow still(g);
+        g.insert(add->clone());
+        EXPECT_EQ(0u, g.journaled());
+        EXPECT_THROW(still.sync(g), std::runtime_error);
+    }
+
+    TesterCell::Dataflow early(g, true);
+    std::size_t b = g.insert(add->clone());
+    {
+        TesterCell::Dataflow late(g, true);
+        g.connect(a, "out", b, "left");
+        EXPECT_EQ(2u, g.journaled());
+        late.sync(g);
+        EXPECT_EQ(2u, g.journaled()); //early has not seen them yet
+        early.sync(g);
+        EXPECT_EQ(0u, g.journaled());
+        g.connect(a, "out", b, "right");
+        early.sync(g);
+        EXPECT_EQ(1u, g.journaled());
+    }
+    //late is gone, nobody needs the edit any more
+    EXPECT_EQ(0u, g.journaled());
+    EXPECT_EQ(2u, early.links(b).size());
+
+    g.remove(a);
+    EXPECT_EQ(1u, g.journaled());
+    EXPECT_TRUE(early.sync(g));
+    EXPECT_EQ(0u, g.journaled());
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_EDITING_HPP_ */
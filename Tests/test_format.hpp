@@ -0,0 +1,72 @@
+/*
+ * test_format.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_FORMAT_HPP_
+#define TESTS_TEST_FORMAT_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/format.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Format, Into_caller_buffer)
+{
+    char buf[8];
+    EXPECT_EQ(1u, TesterCell::format_value(true, buf, sizeof(buf)));
+    EXPECT_EQ('1', buf[0]);
+    EXPECT_EQ(1u, TesterCell::format_value(Quantum::DO_OVER, buf, sizeof(buf)));
+    EXPECT_EQ(std::string("2"), std::string(buf, 1));
+
+    //too small: truncated, but the full length is reported
+    std::string msg("Hello World!");
+    EXPECT_EQ(msg.size(), TesterCell::format_value(msg, buf, sizeof(buf)));
+    EXPECT_EQ(std::string("Hello Wo"), std::string(buf, sizeof(buf)));
+
+    char big[64];
+    std::size_t n = TesterCell::format_value(std::vector<double>{1, 2.5, 3, 4}, big, sizeof(big));
+    EXPECT_EQ(std::string("[1, 2.5, 3, ... (4)]"), std::string(big, n));
+}
+
+TEST(Format, Lazy_str)
+{
+    CellSockets s;
+    s.declare<bool>("b", "A bool", false);
+    s.declare<std::string>("msg", "A long string");
+    TesterCell::lazy_str<bool>(s, "b");
+    TesterCell::lazy_str<std::string>(s, "msg");
+
+    //rendering reflects the value at the time str() is called
+    s["b"] << true;
+    EXPECT_EQ("1", s["b"]->str());
+    std::string long_msg(200, 'x');
+    s["msg"] << long_msg;
+    EXPECT_EQ(long_msg, s["msg"]->str());
+
+    //the renderer follows the socket, not the CellSockets it was declared in
+    CellSockets t;
+    t.insert(s.begin(), s.end());
+    s.clear();
+    t["b"] << false;
+    EXPECT_EQ("0", t["b"]->str());
+
+    //a renderer copied with the whole socket never outlives its socket
+    CellSocket copy;
+    copy = *t["b"];
+    t.clear();
+    EXPECT_EQ("", copy.str());
+    CellSockets u;
+    u["b"] = std::make_shared<CellSocket>(copy);
+    TesterCell::lazy_str<bool>(u, "b");
+    EXPECT_EQ("0", u["b"]->str());
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_FORMAT_HPP_ */
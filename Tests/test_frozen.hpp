@@ -0,0 +1,73 @@
+/*
+ * test_frozen.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_FROZEN_HPP_
+#define TESTS_TEST_FROZEN_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/frozen.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Frozen, Same_result_as_scheduler)
+{
+    //the adders of Scheduler.debugger_resets_at_end, inserted out of order,
+    //built once for each executor
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+
+    auto adders = [&](TesterCell::CircuitGraph &g)
+    {
+        std::size_t adder3 = g.insert(add->clone());
+        std::size_t adder2 = g.insert(add->clone());
+        std::size_t adder1 = g.insert(add->clone());
+        g.connect(adder1, "out", adder2, "left");
+        g.connect(adder2, "out", adder3, "left");
+    };
+    expect_same_as_scheduler(adders, [](TesterCell::CircuitGraph &g, int n)
+    {
+        const std::size_t adder3 = 0, adder1 = 2; //in insertion order
+        TesterCell::FrozenSchedule frozen(g);
+        EXPECT_EQ(3u, frozen.size());
+        EXPECT_EQ(adder1, frozen.cell_index(0));
+        EXPECT_EQ(adder3, frozen.cell_index(2));
+        ReturnCode ret = frozen.execute(n);
+        EXPECT_EQ(4.0, g[adder3]->outputs.get<double>("out"));
+        EXPECT_EQ(4, g[adder3]->outputs["out"]->token_id());
+        return ret;
+    }, 5);
+}
+
+TEST(Frozen, Stops_on_do_over)
+{
+    cell_ptr delay = std::make_shared<Cell_<Delay>>();
+    delay->declare_params();
+    delay->declare_io();
+    delay->inputs["milliseconds"] << 1000;
+    cell_ptr pause = std::make_shared<Cell_<Pause>>();
+    pause->declare_params();
+    pause->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t d = g.insert(delay);
+    std::size_t p = g.insert(pause);
+    g.connect(d, "done", p, "link");
+    TesterCell::FrozenSchedule frozen(g);
+    EXPECT_EQ(Quantum::DO_OVER, frozen.execute(1));
+    EXPECT_FALSE(g[p]->outputs.get<bool>("done"));
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_FROZEN_HPP_ */
@@ -0,0 +1,141 @@
+/*
+ * test_fusion.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_FUSION_HPP_
+#define TESTS_TEST_FUSION_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/batch.h"
+#include "TesterCell/fusion.h"
+#include "TesterCell/profiler.h"
+#include "TesterCell/tester.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Fusion, Chains)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+
+    //a -> b -> c -> d      e fans out, f joins: nothing to fuse there
+    //          \-> e -> f
+    //               \-> g
+    TesterCell::CircuitGraph g;
+    std::vector<std::size_t> k;
+    for(int i = 0; i < 7; i++)
+    {
+        k.push_back(g.insert(add->clone()));
+    }
+    g.connect(k[0], "out", k[1], "left");
+    g.connect(k[1], "out", k[2], "left");
+    g.connect(k[2], "out", k[3], "left");
+    g.connect(k[2], "out", k[4], "left");
+    g.connect(k[4], "out", k[5], "left");
+    g.connect(k[4], "out", k[6], "left");
+    g.connect(k[3], "out", k[5], "right");
+
+    TesterCell::Dataflow flow(g);
+    std::vector<std::vector<std::size_t>> chains = TesterCell::fusible_chains(flow);
+    ASSERT_EQ(5u, chains.size());
+    EXPECT_EQ((std::vector<std::size_t>{k[0], k[1], k[2]}), chains[0]);
+    std::size_t fused = 0;
+    for(const std::vector<std::size_t> &c: chains)
+    {
+        fused += c.size();
+    }
+    EXPECT_EQ(7u, fused);
+}
+
+TEST(Fusion, Control_flow_chain_keeps_its_cells_visible)
+{
+    //Start -> If -> Print -> If -> Print, fused into a single unit
+    cell_ptr start = std::make_shared<Cell_<TesterCell::Start>>();
+    cell_ptr if_proto = std::make_shared<Cell_<TesterCell::If>>();
+    cell_ptr print_proto = std::make_shared<Cell_<TesterCell::Print>>();
+    for(cell_ptr c: {start, if_proto, print_proto})
+    {
+        c->declare_params();
+        c->declare_io();
+    }
+    if_proto->inputs["condition"] << true;
+
+    TesterCell::CircuitGraph g;
+    std::size_t prev = g.insert(start);
+    std::string out = ">>";
+    for(int i = 0; i < 4; i++)
+    {
+        std::size_t next = g.insert(i % 2 ? print_proto->clone() : if_proto->clone());
+        g.connect(prev, out, next, ">>");
+        out = i % 2 ? ">>" : "true >>";
+        prev = next;
+    }
+
+    TesterCell::CellProfiler profiler;
+    for(const cell_ptr &c: g.cells())
+    {
+        profiler.attach(c);
+    }
+    TesterCell::FusedExecutor exec(g);
+    EXPECT_EQ(1u, exec.units());
+    EXPECT_EQ(Quantum::OK, exec.execute(3));
+    EXPECT_EQ(Quantum::OK, g[prev]->outputs.get<ReturnCode>(">>"));
+    EXPECT_EQ(15u, exec.stats().processed);
+    for(const cell_ptr &c: g.cells())
+    {
+        EXPECT_EQ(3u, profiler.histogram(c, TesterCell::CellProfiler::PROCESS).count());
+    }
+    profiler.detach();
+}
+
+TEST(Fusion, Chain_hands_values_on_and_follows_edits)
+{
+    cell_ptr add = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << TesterCell::Batch(64, 1.0);
+    add->inputs["right"] << TesterCell::Batch(64, 1.0);
+
+    //a -> b -> c, then d is appended to the chain before pid 1
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    std::size_t b = g.insert(add->clone());
+    std::size_t c = g.insert(add->clone());
+    g.connect(a, "out", b, "left");
+    g.connect(b, "out", c, "left");
+
+    TesterCell::FusedExecutor exec(g);
+    ASSERT_EQ(1u, exec.units());
+    EXPECT_TRUE(exec.handoff(a) == nullptr);
+    EXPECT_TRUE(exec.handoff(b) != nullptr);
+    EXPECT_TRUE(exec.handoff(c) != nullptr);
+
+    std::size_t d = 0;
+    exec.between_pids([&](int pid)
+    {
+        if(pid == 1)
+        {
+            d = g.insert(add->clone());
+            g.connect(c, "out", d, "left");
+        }
+    });
+    EXPECT_EQ(Quantum::OK, exec.execute(3));
+    EXPECT_EQ(1u, exec.units());
+    EXPECT_EQ(4u, exec.chain(0).size());
+    EXPECT_TRUE(exec.handoff(d) != nullptr);
+    EXPECT_EQ(4.0, g[c]->outputs.get<TesterCell::Batch>("out")[0]);
+    EXPECT_EQ(5.0, g[d]->outputs.get<TesterCell::Batch>("out")[0]);
+    EXPECT_EQ(2, g[d]->outputs["out"]->token_id());
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_FUSION_HPP_ */
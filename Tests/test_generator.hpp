@@ -0,0 +1,101 @@
+/*
+ * test_generator.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_GENERATOR_HPP_
+#define TESTS_TEST_GENERATOR_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/generator.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Generator, Reproducible)
+{
+    TesterCell::GeneratorOptions opts;
+    opts.seed = 7;
+    opts.cells = 500;
+    opts.fan_in = 1.5;
+    opts.mix.print = 0;
+    TesterCell::circuit_graph_ptr g1 = TesterCell::CircuitGenerator(opts).generate();
+    TesterCell::circuit_graph_ptr g2 = TesterCell::CircuitGenerator(opts).generate();
+    EXPECT_EQ(500u, g1->size());
+    ASSERT_EQ(g1->connections().size(), g2->connections().size());
+    EXPECT_GT(g1->connections().size(), 0u);
+    for(std::size_t k = 0; k < g1->connections().size(); k++)
+    {
+        const TesterCell::Connection &a = g1->connections()[k];
+        const TesterCell::Connection &b = g2->connections()[k];
+        EXPECT_EQ(a.from, b.from);
+        EXPECT_EQ(a.output, b.output);
+        EXPECT_EQ(a.to, b.to);
+        EXPECT_EQ(a.input, b.input);
+        //cells only ever consume earlier cells, so the graph is acyclic
+        EXPECT_LT(a.from, a.to);
+    }
+
+    //a different seed gives a different circuit
+    opts.seed = 8;
+    TesterCell::circuit_graph_ptr g3 = TesterCell::CircuitGenerator(opts).generate();
+    bool same = g3->connections().size() == g1->connections().size();
+    for(std::size_t k = 0; same && k < g1->connections().size(); k++)
+    {
+        same = g1->connections()[k].from == g3->connections()[k].from &&
+               g1->connections()[k].to == g3->connections()[k].to;
+    }
+    EXPECT_FALSE(same);
+}
+
+TEST(Generator, Mix_and_fan_out)
+{
+    TesterCell::GeneratorOptions opts;
+    opts.cells = 200;
+    opts.fan_in = 2.0;
+    opts.max_fan_out = 2;
+    opts.mix = TesterCell::CellMix();
+    opts.mix.operation = 0;
+    opts.mix.pause = 0;
+    opts.mix.branch = 0;
+    opts.mix.print = 0;
+    TesterCell::circuit_graph_ptr g = TesterCell::CircuitGenerator(opts).generate();
+    std::vector<int> consumers(g->size(), 0);
+    for(const TesterCell::Connection &c: g->connections())
+    {
+        EXPECT_EQ("out", c.output);
+        consumers[c.from]++;
+    }
+    //Add has a single output, with at most max_fan_out consumers
+    for(int n: consumers)
+    {
+        EXPECT_LE(n, 2);
+    }
+
+    opts.mix.add = 0;
+    EXPECT_THROW(TesterCell::CircuitGenerator(opts).generate(), std::runtime_error);
+}
+
+TEST(Generator, Executes)
+{
+    TesterCell::GeneratorOptions opts;
+    opts.seed = 3;
+    opts.cells = 1000;
+    opts.mix.print = 0;
+    TesterCell::circuit_graph_ptr g = TesterCell::CircuitGenerator(opts).generate();
+    //conditions are always true, nothing waits on a branch never taken
+    for(const TesterCell::Connection &c: g->connections())
+    {
+        EXPECT_NE("false >>", c.output);
+    }
+    Scheduler sched(g->circuit());
+    EXPECT_NO_THROW(sched.execute(2));
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_GENERATOR_HPP_ */
@@ -0,0 +1,72 @@
+/*
+ * test_incremental.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_INCREMENTAL_HPP_
+#define TESTS_TEST_INCREMENTAL_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/incremental.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Incremental, Only_the_dirty_cone_runs)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+
+    //two independent chains of 50 adds
+    TesterCell::CircuitGraph g;
+    std::vector<std::size_t> a, b;
+    for(std::vector<std::size_t> *chain: {&a, &b})
+    {
+        for(int k = 0; k < 50; k++)
+        {
+            chain->push_back(g.insert(add->clone()));
+            if(k)
+            {
+                g.connect((*chain)[k - 1], "out", chain->back(), "left");
+            }
+        }
+    }
+
+    TesterCell::IncrementalExecutor exec(g);
+    EXPECT_EQ(Quantum::OK, exec.execute());
+    EXPECT_EQ(100u, exec.stats().processed);
+    EXPECT_EQ(51.0, g[a.back()]->outputs.get<double>("out"));
+
+    //nothing changed, nothing runs
+    EXPECT_EQ(Quantum::OK, exec.execute());
+    EXPECT_EQ(100u, exec.stats().processed);
+    EXPECT_EQ(100u, exec.stats().skipped);
+
+    //one constant in the middle of a: its tail reruns, b does not
+    g[a[10]]->inputs["right"] << 2.0;
+    EXPECT_EQ(Quantum::OK, exec.execute());
+    EXPECT_EQ(140u, exec.stats().processed);
+    EXPECT_EQ(52.0, g[a.back()]->outputs.get<double>("out"));
+    EXPECT_EQ(2, g[a.back()]->outputs["out"]->token_id());
+    EXPECT_EQ(51.0, g[b.back()]->outputs.get<double>("out"));
+
+    //a touched cell whose output does not change stops the cone right away
+    exec.touch(a[0]);
+    EXPECT_EQ(Quantum::OK, exec.execute());
+    EXPECT_EQ(141u, exec.stats().processed);
+    EXPECT_EQ(4, exec.pid());
+
+    EXPECT_THROW(exec.touch(g.size()), std::runtime_error);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_INCREMENTAL_HPP_ */
@@ -0,0 +1,198 @@
+/*
+ * test_move.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_MOVE_HPP_
+#define TESTS_TEST_MOVE_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/batch.h"
+#include "TesterCell/dataflow.h"
+#include "TesterCell/fusion.h"
+#include "TesterCell/move.h"
+#include "TesterCell/tester.h"
+#include "TesterCell/work_stealing.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Move, Steals_the_payload)
+{
+    using TesterCell::moved;
+    cellsocket_ptr a = make_cellsocket<TesterCell::Batch>();
+    cellsocket_ptr b = make_cellsocket<TesterCell::Batch>();
+    a << TesterCell::Batch(1000, 0.5);
+    a->token_id(7);
+    const double *buffer = a->get<TesterCell::Batch>().data();
+
+    b << moved(a);
+    EXPECT_EQ(1000u, b->get<TesterCell::Batch>().size());
+    EXPECT_EQ(buffer, b->get<TesterCell::Batch>().data()); //not copied
+    EXPECT_EQ(7, b->token_id());                           //as in Token_transfer
+}
+
+TEST(Move, Notifies_the_consumer)
+{
+    using TesterCell::moved;
+    cellsocket_ptr a = make_cellsocket<std::string>();
+    cellsocket_ptr b = make_cellsocket<std::string>();
+    a << std::string("moved");
+    std::string seen;
+    b->set_callback<std::string>([&](const std::string &s){seen = s;});
+    b << moved(a);
+    EXPECT_EQ("moved", seen);
+    EXPECT_FALSE(b->dirty());
+}
+
+TEST(Move, Falls_back_to_copy)
+{
+    using TesterCell::moved;
+    //an untyped socket takes a copy, like b << a in Copyness
+    cellsocket_ptr a = make_cellsocket<float>();
+    cellsocket_ptr b(new CellSocket);
+    a << 0.5f;
+    b << moved(a);
+    EXPECT_EQ(0.5f, b->get<float>());
+    EXPECT_EQ(0.5f, a->get<float>());
+    EXPECT_TRUE(TesterCell::mover_for(*a) == nullptr);
+
+    //mismatched types still throw
+    cellsocket_ptr s = make_cellsocket<std::string>();
+    EXPECT_THROW(s << moved(a), std::exception);
+}
+
+TEST(Move, Single_consumer_only)
+{
+    cell_ptr add = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << TesterCell::Batch(64, 1.0);
+    add->inputs["right"] << TesterCell::Batch(64, 1.0);
+
+    //a -> b, a -> c, c -> d: only c -> d has a single consumer
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    std::size_t b = g.insert(add->clone());
+    std::size_t c = g.insert(add->clone());
+    std::size_t d = g.insert(add->clone());
+    g.connect(a, "out", b, "left");
+    g.connect(a, "out", c, "left");
+    g.connect(c, "out", d, "left");
+
+    TesterCell::DataflowExecutor exec(g);
+    exec.move_single_consumer(true);
+    EXPECT_TRUE(exec.dataflow().links(b).front().mover == nullptr);
+    EXPECT_TRUE(exec.dataflow().links(c).front().mover == nullptr);
+    EXPECT_TRUE(exec.dataflow().links(d).front().mover != nullptr);
+    EXPECT_EQ(Quantum::OK, exec.execute(3));
+    EXPECT_EQ(4.0, g[d]->outputs.get<TesterCell::Batch>("out")[0]);
+    EXPECT_EQ(2, g[d]->outputs["out"]->token_id());
+}
+
+TEST(Move, Only_from_cells_that_opt_in)
+{
+    //Hello is not registered as a move source, its consumer keeps copying
+    cell_ptr hello = std::make_shared<Cell_<TesterCell::Hello>>();
+    hello->declare_params();
+    hello->declare_io();
+    cell_ptr print = std::make_shared<Cell_<TesterCell::Print>>();
+    print->declare_params();
+    print->declare_io();
+    EXPECT_FALSE(TesterCell::is_move_source(*hello));
+
+    TesterCell::CircuitGraph g;
+    std::size_t h = g.insert(hello);
+    std::size_t p = g.insert(print);
+    g.connect(h, "msg", p, "msg");
+    TesterCell::Dataflow flow(g);
+    flow.move_single_consumer(true);
+    EXPECT_TRUE(flow.links(p).front().mover == nullptr);
+
+    cell_ptr add = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    EXPECT_TRUE(TesterCell::is_move_source(*add));
+}
+
+TEST(Move, Once_per_pid)
+{
+    //a retried consumer must see the value moved into it, not have it
+    //swapped back by a second pull
+    cell_ptr add = std::make_shared<Cell_<TesterCell::BatchAdd>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << TesterCell::Batch(64, 1.0);
+    add->inputs["right"] << TesterCell::Batch(64, 1.0);
+    cell_ptr reluctant = std::make_shared<Cell_<Reluctant<TesterCell::Batch>>>();
+    reluctant->declare_params();
+    reluctant->parameters["retries"] << 2;
+    reluctant->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add);
+    std::size_t r = g.insert(reluctant);
+    g.connect(a, "out", r, "in");
+
+    TesterCell::DataflowExecutor dataflow(g);
+    dataflow.move_single_consumer(true);
+    ASSERT_TRUE(dataflow.dataflow().links(r).front().mover != nullptr);
+    EXPECT_EQ(Quantum::OK, dataflow.execute(3));
+    EXPECT_EQ(6u, dataflow.stats().retries);
+    EXPECT_EQ(2.0, g[r]->outputs.get<double>("out"));
+
+    g[r]->outputs["out"] << 0.0;
+    TesterCell::FusedExecutor fused(g);
+    fused.move_single_consumer(true);
+    EXPECT_EQ(Quantum::OK, fused.execute(3));
+    EXPECT_EQ(2.0, g[r]->outputs.get<double>("out"));
+
+    g[r]->outputs["out"] << 0.0;
+    TesterCell::WorkStealingExecutor stealing(g, 2);
+    stealing.move_single_consumer(true);
+    EXPECT_EQ(Quantum::OK, stealing.execute(3));
+    EXPECT_EQ(2.0, g[r]->outputs.get<double>("out"));
+}
+
+TEST(Move, Inline_copy)
+{
+    cellsocket_ptr a = make_cellsocket<ReturnCode>();
+    cellsocket_ptr b = make_cellsocket<ReturnCode>();
+    a << Quantum::DO_OVER;
+    a->token_id(3);
+    TesterCell::SocketMover copy = TesterCell::inline_copy_for(*a);
+    ASSERT_TRUE(copy != nullptr);
+    const ReturnCode *storage = &b->get<ReturnCode>();
+    copy(*b, *a);
+    EXPECT_EQ(Quantum::DO_OVER, b->get<ReturnCode>());
+    EXPECT_EQ(3, b->token_id());
+    EXPECT_EQ(storage, &b->get<ReturnCode>()); //assigned in place
+    EXPECT_EQ(Quantum::DO_OVER, a->get<ReturnCode>());
+
+    //large or non trivial values keep the regular copy
+    EXPECT_TRUE(TesterCell::inline_copy_for(*make_cellsocket<TesterCell::Batch>()) == nullptr);
+    EXPECT_TRUE(TesterCell::inline_copy_for(*make_cellsocket<std::string>()) == nullptr);
+    EXPECT_TRUE(TesterCell::inline_copy_for(CellSocket()) == nullptr);
+
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+    TesterCell::CircuitGraph g;
+    std::size_t x = g.insert(add->clone());
+    std::size_t y = g.insert(add->clone());
+    g.connect(x, "out", y, "left");
+    TesterCell::DataflowExecutor exec(g);
+    EXPECT_TRUE(exec.dataflow().links(y).front().copy != nullptr);
+    EXPECT_EQ(Quantum::OK, exec.execute(2));
+    EXPECT_EQ(3.0, g[y]->outputs.get<double>("out"));
+    EXPECT_EQ(1, g[y]->inputs["left"]->token_id());
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_MOVE_HPP_ */
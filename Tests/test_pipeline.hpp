@@ -0,0 +1,101 @@
+/*
+ * test_pipeline.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_PIPELINE_HPP_
+#define TESTS_TEST_PIPELINE_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/pipeline.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+namespace Quantum
+{
+
+TEST(Pipeline, No_token_lost_or_overwritten)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["right"] << 1.0;
+    cell_ptr counter = std::make_shared<Cell_<Counter>>();
+    counter->declare_params();
+    counter->declare_io();
+    cell_ptr total = std::make_shared<Cell_<Sum>>();
+    total->declare_params();
+    total->declare_io();
+
+    //counter -> 8 adds -> sum, every pid carries a different value
+    TesterCell::CircuitGraph g;
+    std::size_t prev = g.insert(counter);
+    std::string out = "count";
+    for(int k = 0; k < 8; k++)
+    {
+        std::size_t next = g.insert(add->clone());
+        g.connect(prev, out, next, "left");
+        prev = next;
+        out = "out";
+    }
+    std::size_t sum = g.insert(total);
+    g.connect(prev, out, sum, "value");
+
+    TesterCell::PipelineExecutor exec(g, g.size(), 2);
+    EXPECT_EQ(g.size(), exec.stages());
+    const int n = 200;
+    EXPECT_EQ(Quantum::OK, exec.execute(n));
+    //sum of (pid + 1) + 8 over all pids
+    EXPECT_EQ(n * (n + 1) / 2 + 8.0 * n, g[sum]->outputs.get<double>("total"));
+    EXPECT_EQ(n - 1, g[sum]->outputs["total"]->token_id());
+    EXPECT_EQ(static_cast<std::uint64_t>(n) * g.size(), exec.stats().processed);
+}
+
+TEST(Pipeline, Stages_overlap)
+{
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    sleeper->inputs["milliseconds"] << 5;
+
+    TesterCell::CircuitGraph g;
+    std::size_t prev = g.insert(sleeper->clone());
+    for(int k = 1; k < 20; k++)
+    {
+        std::size_t next = g.insert(sleeper->clone());
+        g.connect(prev, "done", next, "link");
+        prev = next;
+    }
+
+    //lock-step this would take 20 pids * 20 stages * 5ms = 2000ms, pipelined
+    //about (20 + 19) * 5ms
+    TesterCell::PipelineExecutor exec(g, 20);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Quantum::OK, exec.execute(20));
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(ms, 1000);
+    EXPECT_EQ(19, g[prev]->outputs["done"]->token_id());
+}
+
+TEST(Pipeline, Cycle_is_rejected)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    TesterCell::CircuitGraph g;
+    std::size_t a = g.insert(add->clone());
+    std::size_t b = g.insert(add->clone());
+    g.connect(a, "out", b, "left");
+    g.connect(b, "out", a, "left");
+    EXPECT_THROW(TesterCell::PipelineExecutor(g, 2), std::runtime_error);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_PIPELINE_HPP_ */
@@ -0,0 +1,51 @@
+/*
+ * test_plugin.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_PLUGIN_HPP_
+#define TESTS_TEST_PLUGIN_HPP_
+
+#include "Engine/all.hpp"
+#include "Engine/kernel.h"
+#include "testercell.h"
+#include "gtest/gtest.h"
+
+#include <set>
+#include <string>
+
+namespace Quantum
+{
+
+TEST(Plugin, Cell_table)
+{
+    std::size_t count = 0;
+    const TesterCell::CellEntry *entries = TesterCell::plugin_cells(count);
+    EXPECT_GE(count, 11u);
+    std::set<std::string> names;
+    for(std::size_t k = 0; k < count; k++)
+    {
+        EXPECT_TRUE(names.insert(entries[k].name).second) << entries[k].name;
+        cell_ptr c = entries[k].make(entries[k]);
+        ASSERT_TRUE(c != nullptr);
+        EXPECT_EQ(entries[k].name, c->metadata.get<std::string>("name"));
+        EXPECT_NO_THROW(c->init());
+    }
+}
+
+TEST(Plugin, Register_cells)
+{
+    //how a host linking the static library registers the cells
+    Kernel *kernel = Kernel::getKernel();
+    TesterCell::register_cells(*kernel);
+    cell_ptr hello = kernel->getCellRegistry().getCell("Quantum::TesterCell::Hello::Hello");
+    ASSERT_TRUE(hello != nullptr);
+    EXPECT_EQ("Hello", hello->metadata.get<std::string>("name"));
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_PLUGIN_HPP_ */
@@ -0,0 +1,105 @@
+/*
+ * test_pool.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_POOL_HPP_
+#define TESTS_TEST_POOL_HPP_
+
+#include "Engine/all.hpp"
+#include "cells.hpp"
+#include "TesterCell/pool.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Pool, Recycles_with_prototype_values)
+{
+    cell_ptr proto = std::make_shared<Cell_<Operation>>();
+    proto->declare_params();
+    proto->declare_io();
+    proto->inputs["a"] << 2;
+    TesterCell::CellPool pool(proto);
+
+    cell_ptr c = pool.acquire();
+    const Cell *first = c.get();
+    c->parameters["minus"] << true;
+    c->inputs["a"] << 5;
+    c->configure();
+    c->process();
+    EXPECT_EQ(5, c->outputs.get<int>("ans"));
+    c.reset();
+    EXPECT_EQ(1u, pool.available());
+
+    //the same cell comes back as the prototype left it
+    c = pool.acquire();
+    EXPECT_EQ(first, c.get());
+    EXPECT_EQ(1u, pool.created());
+    EXPECT_FALSE(c->parameters.get<bool>("minus"));
+    EXPECT_EQ(2, c->inputs.get<int>("a"));
+    EXPECT_EQ(0, c->outputs.get<int>("ans"));
+}
+
+TEST(Pool, Circuit_edits)
+{
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    cell_ptr s1 = sleeper->clone();
+    std::unique_ptr<TesterCell::CellPool> pool(new TesterCell::CellPool(sleeper, 2));
+    pool->reserve(2);
+    EXPECT_EQ(2u, pool->created());
+
+    circuit_ptr c(new Circuit);
+    c->insert(s1);
+    for(int k = 0; k < 10; k++)
+    {
+        cell_ptr s2 = pool->acquire();
+        SocketHandle<bool> done = s2->outputs["done"];
+        c->insert(s2);
+        c->connect(s1, "done", s2, "link");
+        Scheduler(c).execute(1);
+        EXPECT_TRUE(*done);
+        c->remove(s2);
+    }
+    EXPECT_EQ(2u, pool->created());
+
+    //cells outliving their pool are freed normally
+    cell_ptr kept = pool->acquire();
+    pool.reset();
+    EXPECT_FALSE(kept->outputs.get<bool>("done"));
+    kept.reset();
+}
+
+TEST(Pool, Recycled_cells_start_clean)
+{
+    cell_ptr proto = std::make_shared<Cell_<Operation>>();
+    proto->declare_params();
+    proto->declare_io();
+    proto->inputs["a"] << 2;
+    TesterCell::CellPool pool(proto);
+
+    cell_ptr c = pool.acquire();
+    c->profile[Cell::T_PROCESS] = true;
+    c.reset();
+    c = pool.acquire();
+    EXPECT_EQ(1u, pool.created());
+    EXPECT_FALSE(c->profile[Cell::T_PROCESS]);
+
+    //a cell that cannot be restored is freed, not pooled, and the handle's
+    //deleter does not throw
+    c->inputs["a"] = make_cellsocket<std::string>();
+    c.reset();
+    EXPECT_EQ(0u, pool.available());
+    c = pool.acquire();
+    EXPECT_EQ(2u, pool.created());
+    EXPECT_EQ(2, c->inputs.get<int>("a"));
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_POOL_HPP_ */
@@ -12,9 +12,11 @@
 
 #include "Engine/all.hpp"
 #include "cells.hpp"
+#include "TesterCell/profiler.h"
 #include "gtest/gtest.h"
 
 #include <chrono>
+#include <sstream>
 
 namespace Quantum
 {
@@ -45,6 +47,92 @@ TEST(Profiling, timeit)
     EXPECT_NEAR(650, e->us.count(), 10);
     */
 }
+
+TEST(Profiling, Histogram)
+{
+    TesterCell::LatencyHistogram h;
+    EXPECT_EQ(0, h.percentile(0.5).count());
+    for(int us = 1; us <= 1000; us++)
+    {
+        h.record(std::chrono::microseconds(us));
+    }
+    EXPECT_EQ(1000u, h.count());
+    EXPECT_EQ(1000, h.max().count());
+    //buckets are at most 1/16 wide
+    EXPECT_NEAR(500, h.percentile(0.5).count(), 500 / 16);
+    EXPECT_NEAR(990, h.percentile(0.99).count(), 990 / 16);
+    EXPECT_EQ(1000, h.percentile(1.0).count());
+    //small values are exact
+    h.reset();
+    h.record(std::chrono::microseconds(7));
+    EXPECT_EQ(7, h.percentile(0.5).count());
+}
+
+TEST(Profiling, Histograms_across_execute)
+{
+    TesterCell::CellProfiler profiler;
+    cell_ptr s1 = std::make_shared<Cell_<Sleeper>>();
+    profiler.declare(s1);
+    cell_ptr s2 = s1->clone();
+    s1->name("s1");
+    s2->name("s2");
+    s1->inputs["milliseconds"] << 5;
+    s2->inputs["milliseconds"] << 20;
+    profiler.attach(s1);
+    profiler.attach(s2);
+    EXPECT_TRUE(s1->profile[Cell::T_PROCESS]);
+
+    circuit_ptr c(new Circuit);
+    c->insert(s1);
+    c->insert(s2);
+    Scheduler(c).execute(10);
+
+    const TesterCell::LatencyHistogram &h1 =
+            profiler.histogram(s1, TesterCell::CellProfiler::PROCESS);
+    const TesterCell::LatencyHistogram &h2 =
+            profiler.histogram(s2, TesterCell::CellProfiler::PROCESS);
+    //every pid is recorded, not just the last one
+    EXPECT_EQ(10u, h1.count());
+    EXPECT_EQ(10u, h2.count());
+    EXPECT_NEAR(5000, h1.percentile(0.5).count(), 2000);
+    EXPECT_NEAR(20000, h2.percentile(0.5).count(), 3000);
+    EXPECT_EQ(1u, profiler.histogram(s1, TesterCell::CellProfiler::DECLARE).count());
+
+    std::ostringstream dump;
+    profiler.dump(dump);
+    EXPECT_NE(std::string::npos, dump.str().find("s2"));
+
+    profiler.detach();
+    EXPECT_FALSE(s1->profile[Cell::T_PROCESS]);
+    EXPECT_THROW(profiler.histogram(s1, TesterCell::CellProfiler::PROCESS),
+            std::runtime_error);
+}
+
+TEST(Profiling, Shared_profile_flag)
+{
+    cell_ptr s = std::make_shared<Cell_<Sleeper>>();
+    s->declare_params();
+    s->declare_io();
+    {
+        TesterCell::CellProfiler first, second;
+        first.attach(s);
+        first.attach(s); //attaching twice is one request
+        second.attach(s);
+        first.detach();
+        //second still needs the timings
+        EXPECT_TRUE(s->profile[Cell::T_PROCESS]);
+        second.detach();
+        EXPECT_FALSE(s->profile[Cell::T_PROCESS]);
+    }
+
+    //a flag turned on by hand stays on
+    s->profile[Cell::T_PROCESS] = true;
+    {
+        TesterCell::CellProfiler profiler;
+        profiler.attach(s);
+    }
+    EXPECT_TRUE(s->profile[Cell::T_PROCESS]);
+}
 }
 
 #endif /* TESTS_TEST_PROFILING_HPP_ */
@@ -220,6 +220,39 @@ namespace Quantum
         EXPECT_LT(ms.count(), 400);
 
     }
+    TEST(Scheduler, Parallel_delays)
+    {
+        cell_ptr delay = std::make_shared<Cell_<Delay>>();
+        delay->declare_params();
+        delay->declare_io();
+
+        circuit_ptr c(new Circuit);
+        std::vector<cell_ptr> delays;
+        for(int k = 0; k < 10000; k++)
+        {
+            cell_ptr d = delay->clone();
+            d->inputs["milliseconds"] << 100;
+            c->insert(d);
+            delays.push_back(d);
+        }
+
+        Scheduler sched(c);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        sched.execute(1);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        std::chrono::milliseconds ms = std::chrono::duration_cast<std::chrono::milliseconds>(t2-t1);
+
+        //10k delays overlap rather than run one per thread at a time; the
+        //scheduler polls them, so how close it gets to one delay depends
+        //on the load (see Dataflow.Delays_sleep_until_due for the bound
+        //with timer wakeups)
+        EXPECT_GE(ms.count(), 100);
+        EXPECT_LT(ms.count(), 500);
+        for(const cell_ptr &d: delays)
+        {
+            EXPECT_TRUE(d->outputs["done"]->get<bool>());
+        }
+    }
     TEST(Scheduler, Circuit_editing)
     {
         cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
@@ -0,0 +1,88 @@
+/*
+ * test_shared.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_SHARED_HPP_
+#define TESTS_TEST_SHARED_HPP_
+
+#include "Engine/all.hpp"
+#include "cells.hpp"
+#include "TesterCell/dataflow.h"
+#include "TesterCell/shared.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(Shared, Copy_on_write)
+{
+    TesterCell::SharedBatch a(TesterCell::Batch(100, 1.0));
+    TesterCell::SharedBatch b = a;
+    EXPECT_EQ(2, a.use_count());
+    EXPECT_EQ(a->data(), b->data());
+
+    //the writer gets its own copy, the other holder is untouched
+    b.mutate()[0] = 2.0;
+    EXPECT_NE(a->data(), b->data());
+    EXPECT_EQ(1.0, (*a)[0]);
+    EXPECT_EQ(2.0, (*b)[0]);
+    EXPECT_TRUE(a != b);
+
+    //a sole holder writes in place
+    const double *buffer = b->data();
+    b.mutate()[1] = 3.0;
+    EXPECT_EQ(buffer, b->data());
+}
+
+TEST(Shared, Registered_type)
+{
+    TesterCell::register_shared_types();
+    cellsocket_ptr a = make_cellsocket<TesterCell::SharedBatch>();
+    CellSocket b = Quantum::Registry::CellSocket::get(a->type_name());
+    EXPECT_TRUE(b.same_type(*a));
+
+    //sockets hand the payload on without copying it
+    cellsocket_ptr c = make_cellsocket<TesterCell::SharedBatch>();
+    a << TesterCell::SharedBatch(TesterCell::Batch(100, 1.0));
+    c << a;
+    EXPECT_EQ(a->get<TesterCell::SharedBatch>()->data(),
+            c->get<TesterCell::SharedBatch>()->data());
+}
+
+TEST(Shared, Fan_out_shares_payload)
+{
+    cell_ptr broadcast = std::make_shared<Cell_<TesterCell::Broadcast>>();
+    broadcast->declare_params();
+    broadcast->declare_io();
+    broadcast->inputs["in"] << TesterCell::Batch(1000, 0.5);
+    cell_ptr front = std::make_shared<Cell_<Front<TesterCell::SharedBatch, TesterCell::Batch>>>();
+    front->declare_params();
+    front->declare_io();
+
+    TesterCell::CircuitGraph g;
+    std::size_t b = g.insert(broadcast);
+    std::vector<std::size_t> consumers;
+    for(int k = 0; k < 4; k++)
+    {
+        consumers.push_back(g.insert(front->clone()));
+        g.connect(b, "out", consumers.back(), "in");
+    }
+    TesterCell::DataflowExecutor exec(g);
+    EXPECT_EQ(Quantum::OK, exec.execute(1));
+
+    const TesterCell::SharedBatch &out = broadcast->outputs.get<TesterCell::SharedBatch>("out");
+    EXPECT_EQ(5, out.use_count()); //the output and every input, one buffer
+    for(std::size_t k: consumers)
+    {
+        EXPECT_EQ(out->data(), g[k]->inputs.get<TesterCell::SharedBatch>("in")->data());
+        EXPECT_EQ(0.5, g[k]->outputs.get<double>("out"));
+    }
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_SHARED_HPP_ */
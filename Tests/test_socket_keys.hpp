@@ -0,0 +1,94 @@
+/*
+ * test_socket_keys.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_SOCKET_KEYS_HPP_
+#define TESTS_TEST_SOCKET_KEYS_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/socket_keys.h"
+#include "gtest/gtest.h"
+
+namespace Quantum
+{
+
+TEST(SocketKeys, Interned)
+{
+    TesterCell::SocketKey a("condition"), b("condition"), c(">>");
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_EQ("condition", a.name());
+}
+
+TEST(SocketKeys, Same_sockets_as_strings)
+{
+    CellSockets ts;
+    ts.declare<int>("x");
+    ts.declare<float>("y");
+    ts.declare<std::string>("z");
+    TesterCell::SocketKey x("x"), y("y"), z("z"), w("w");
+    TesterCell::SocketTable t(ts);
+    EXPECT_EQ(3u, t.size());
+    EXPECT_EQ(ts["x"], t[x]);
+    EXPECT_FALSE(t.contains(w));
+
+    //both APIs reach the same value
+    t[x] << 2;
+    EXPECT_EQ(2, t.get<int>(x));
+    t.get<int>(x) = 3;
+    EXPECT_EQ(3, ts.get<int>("x"));
+    t.get<std::string>(z) = "z";
+    EXPECT_EQ("z", ts.get<std::string>("z"));
+    ts["y"] << 1.5f;
+    EXPECT_EQ(1.5f, t.get<float>(y));
+
+    //and fail the same way
+    EXPECT_THROW(t.get<float>(x), std::runtime_error);
+    EXPECT_THROW(t[z] << 2, std::runtime_error);
+    EXPECT_THROW(t[w], std::runtime_error);
+    EXPECT_THROW(t.get<int>(w), std::runtime_error);
+}
+
+TEST(SocketKeys, Follows_replaced_values)
+{
+    CellSockets ts;
+    ts.declare<int>("x");
+    TesterCell::SocketKey x("x");
+    TesterCell::SocketTable t(ts);
+    t[x] << 1;
+    EXPECT_EQ(1, t.get<int>(x));
+
+    //assigning a whole socket may swap out the value's storage
+    CellSocket other(7, "replacement");
+    *ts["x"] = other;
+    EXPECT_EQ(7, t.get<int>(x));
+    t.get<int>(x) = 8;
+    EXPECT_EQ(8, ts.get<int>("x"));
+    EXPECT_EQ(7, other.get<int>());
+}
+
+TEST(SocketKeys, Type_ids)
+{
+    EXPECT_EQ(TesterCell::type_id<int>(), TesterCell::type_id(*make_cellsocket<int>()));
+    EXPECT_NE(TesterCell::type_id<int>(), TesterCell::type_id<float>());
+    EXPECT_TRUE(TesterCell::type_id(CellSocket()) == nullptr);
+
+    //a socket given its type after the table was built is resolved again
+    CellSockets ts;
+    ts["w"] = cellsocket_ptr(new CellSocket);
+    TesterCell::SocketKey w("w");
+    TesterCell::SocketTable t(ts);
+    cellsocket_ptr two = make_cellsocket<int>();
+    two << 2;
+    ts["w"] << two;
+    EXPECT_EQ(2, t.get<int>(w));
+    EXPECT_THROW(t.get<float>(w), std::runtime_error);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_SOCKET_KEYS_HPP_ */
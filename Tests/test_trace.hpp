@@ -0,0 +1,114 @@
+/*
+ * test_trace.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_TRACE_HPP_
+#define TESTS_TEST_TRACE_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/profiler.h"
+#include "TesterCell/tester.h"
+#include "TesterCell/trace.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+namespace Quantum
+{
+
+TEST(Trace, Chrome_json)
+{
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    cell_ptr s1 = sleeper->clone();
+    cell_ptr s2 = sleeper->clone();
+    s1->name("s1");
+    s2->name("s2 \"quoted\"");
+    s1->inputs["milliseconds"] << 10;
+    s2->inputs["milliseconds"] << 10;
+    circuit_ptr c(new Circuit);
+    c->insert(s1);
+    c->insert(s2);
+    c->connect(s1, "done", s2, "link");
+
+    TesterCell::TraceRecorder trace;
+    trace.attach(s1);
+    trace.attach(s2);
+    Scheduler sched(c);
+    trace.execute(sched, 2);
+
+    std::ostringstream out;
+    trace.write(out);
+    std::string json = out.str();
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"s1\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"s2 \\\"quoted\\\"\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"execute(2)\""));
+    EXPECT_NE(std::string::npos, json.find("\"pid\":1,\"attempt\":1,\"result\":0"));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+
+    EXPECT_THROW(trace.write(std::string("/nonexistent/dir/trace.json")),
+            std::runtime_error);
+    trace.detach();
+    EXPECT_FALSE(s1->profile[Cell::T_PROCESS]);
+}
+
+TEST(Trace, Attempts_follow_the_pid)
+{
+    //If only writes the output of the branch taken, the other one keeps
+    //its old token
+    cell_ptr branch = std::make_shared<Cell_<TesterCell::If>>();
+    branch->declare_params();
+    branch->declare_io();
+    branch->inputs["condition"] << true;
+    branch->inputs[">>"] << Quantum::OK;
+    circuit_ptr c(new Circuit);
+    c->insert(branch);
+
+    TesterCell::TraceRecorder trace;
+    trace.attach(branch);
+    Scheduler sched(c);
+    trace.execute(sched, 3);
+
+    std::ostringstream out;
+    trace.write(out);
+    std::string json = out.str();
+    EXPECT_NE(std::string::npos, json.find("\"pid\":2,\"attempt\":1,\"result\":0"));
+    EXPECT_EQ(std::string::npos, json.find("\"attempt\":2"));
+    trace.detach();
+}
+
+TEST(Trace, Alongside_a_profiler)
+{
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    sleeper->inputs["milliseconds"] << 1;
+    circuit_ptr c(new Circuit);
+    c->insert(sleeper);
+
+    TesterCell::CellProfiler profiler;
+    profiler.attach(sleeper);
+    {
+        TesterCell::TraceRecorder trace;
+        trace.attach(sleeper);
+        Scheduler sched(c);
+        trace.execute(sched, 3);
+    }
+    //the recorder is gone, the profiler keeps timing the cell
+    EXPECT_TRUE(sleeper->profile[Cell::T_PROCESS]);
+    Scheduler(c).execute(2);
+    EXPECT_EQ(5u, profiler.histogram(sleeper, TesterCell::CellProfiler::PROCESS).count());
+    profiler.detach();
+    EXPECT_FALSE(sleeper->profile[Cell::T_PROCESS]);
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_TRACE_HPP_ */
@@ -0,0 +1,140 @@
+/*
+ * test_work_stealing.hpp
+ *
+ * Copyright (c) Thomas - All Rights Reserved
+ * Unauthorized copying of this file, via any medium is strictly prohibited
+ * Proprietary and confidential
+ */
+
+#ifndef TESTS_TEST_WORK_STEALING_HPP_
+#define TESTS_TEST_WORK_STEALING_HPP_
+
+#include "Engine/all.hpp"
+#include "TesterCell/work_stealing.h"
+#include "cells.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+namespace Quantum
+{
+
+TEST(WorkStealing, Deque)
+{
+    TesterCell::WorkDeque d(4);
+    EXPECT_EQ(TesterCell::WorkDeque::EMPTY, d.pop());
+    d.push(1);
+    d.push(2);
+    d.push(3);
+    EXPECT_EQ(1u, d.steal()); //thieves take the oldest
+    EXPECT_EQ(3u, d.pop());   //the owner the newest
+    EXPECT_EQ(2u, d.pop());
+    EXPECT_EQ(TesterCell::WorkDeque::EMPTY, d.steal());
+}
+
+TEST(WorkStealing, Same_result_as_scheduler)
+{
+    cell_ptr add = std::make_shared<Cell_<Add>>();
+    add->declare_params();
+    add->declare_io();
+    add->inputs["left"] << 1.0;
+    add->inputs["right"] << 1.0;
+
+    //stacked diamonds, every bottom is 2 * top, built once for each executor
+    auto diamonds = [&](TesterCell::CircuitGraph &g)
+    {
+        std::size_t top = g.insert(add->clone());
+        for(int k = 0; k < 50; k++)
+        {
+            std::size_t l = g.insert(add->clone());
+            std::size_t r = g.insert(add->clone());
+            std::size_t bottom = g.insert(add->clone());
+            g.connect(top, "out", l, "left");
+            g.connect(top, "out", r, "left");
+            g.connect(l, "out", bottom, "left");
+            g.connect(r, "out", bottom, "right");
+            top = bottom;
+        }
+    };
+    expect_same_as_scheduler(diamonds, [](TesterCell::CircuitGraph &g, int n)
+    {
+        const std::size_t top = g.size() - 1; //the last bottom
+        TesterCell::WorkStealingExecutor exec(g, 4);
+        EXPECT_EQ(4u, exec.threads());
+        ReturnCode ret = exec.execute(n);
+        EXPECT_EQ(n * g.size(), exec.stats().processed);
+        EXPECT_EQ(n - 1, g[top]->outputs["out"]->token_id());
+        double expected = 2.0;
+        for(int k = 0; k < 50; k++)
+        {
+            expected = 2 * (expected + 1.0);
+        }
+        EXPECT_EQ(expected, g[top]->outputs.get<double>("out"));
+        return ret;
+    }, 20);
+}
+
+TEST(WorkStealing, Independent_branches_in_parallel)
+{
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    sleeper->inputs["milliseconds"] << 100;
+
+    //eight chains of two 100ms pauses
+    TesterCell::CircuitGraph g;
+    for(int k = 0; k < 8; k++)
+    {
+        std::size_t first = g.insert(sleeper->clone());
+        std::size_t second = g.insert(sleeper->clone());
+        g.connect(first, "done", second, "link");
+    }
+
+    TesterCell::WorkStealingExecutor exec(g, 8);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(Quantum::OK, exec.execute(1));
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    EXPECT_LT(ms, 400);
+    for(const cell_ptr &c: g.cells())
+    {
+        EXPECT_TRUE(c->outputs.get<bool>("done"));
+    }
+}
+
+TEST(WorkStealing, Stall_is_abandoned)
+{
+    cell_ptr blocker = std::make_shared<Cell_<Delay>>();
+    blocker->declare_params();
+    blocker->declare_io();
+    blocker->inputs["milliseconds"] << 60000;
+
+    TesterCell::CircuitGraph g;
+    g.insert(blocker);
+    TesterCell::WorkStealingExecutor exec(g, 2);
+    exec.stall_timeout(std::chrono::milliseconds(20));
+    EXPECT_EQ(Quantum::DO_OVER, exec.execute(10));
+    EXPECT_EQ(1u, exec.stats().stalls);
+}
+
+TEST(WorkStealing, Slow_cell_is_not_a_stall)
+{
+    //idle workers see nothing finish while the pause runs, but it is not
+    //waiting on itself
+    cell_ptr sleeper = std::make_shared<Cell_<Pause>>();
+    sleeper->declare_params();
+    sleeper->declare_io();
+    sleeper->inputs["milliseconds"] << 100;
+
+    TesterCell::CircuitGraph g;
+    g.insert(sleeper);
+    TesterCell::WorkStealingExecutor exec(g, 4);
+    exec.stall_timeout(std::chrono::milliseconds(20));
+    EXPECT_EQ(Quantum::OK, exec.execute(2));
+    EXPECT_EQ(0u, exec.stats().stalls);
+    EXPECT_EQ(1, g[0]->outputs["done"]->token_id());
+}
+
+}//Quantum namespace
+
+#endif /* TESTS_TEST_WORK_STEALING_HPP_ */
@@ -11,62 +11,75 @@
 #include "Tests/cells.hpp"
 
 #include "TesterCell/tester.h"
+#include "TesterCell/batch.h"
+#include "TesterCell/shared.h"
 
-extern "C" TESTERCELL_API int getEngineVersion()
-{
-    return 1;
-}
+namespace {
 
-extern "C" TESTERCELL_API void registerPlugin(Quantum::Kernel &kernel)
+using Quantum::TesterCell::CellEntry;
+
+template<typename T>
+Quantum::cell_ptr make(const CellEntry &entry)
 {
     using namespace Quantum;
-    std::vector<cell_ptr> cells_to_add;
-
-    Cell_<TesterCell::If>::SHORT_DOC = "If/Else";
-    Cell_<TesterCell::If>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<TesterCell::If>::CELL_NAME = "If";
-    cell_ptr If(new Cell_<TesterCell::If>());
-    If->metadata["name"] << std::string("If");
-    cells_to_add.push_back(If);
-
-    Cell_<TesterCell::Print>::SHORT_DOC = "Printer";
-    Cell_<TesterCell::Print>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<TesterCell::Print>::CELL_NAME = "Print";
-    cell_ptr print(new Cell_<TesterCell::Print>());
-    print->metadata["name"] << std::string("Print");
-    cells_to_add.push_back(print);
+    Cell_<T>::SHORT_DOC = entry.doc;
+    Cell_<T>::MODULE_NAME = "TesterCellPlugin";
+    Cell_<T>::CELL_NAME = entry.name;
+    cell_ptr c(new Cell_<T>());
+    c->metadata["name"] << std::string(entry.name);
+    return c;
+}
 
-    Cell_<TesterCell::Start>::SHORT_DOC = "Starter";
-    Cell_<TesterCell::Start>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<TesterCell::Start>::CELL_NAME = "Start";
-    cell_ptr start(new Cell_<TesterCell::Start>());
-    start->metadata["name"] << std::string("Start");
-    cells_to_add.push_back(start);
+constexpr CellEntry cells[] = {
+    {"If", "If/Else", &make<Quantum::TesterCell::If>},
+    {"Print", "Printer", &make<Quantum::TesterCell::Print>},
+    {"Start", "Starter", &make<Quantum::TesterCell::Start>},
+    {"Hello", "Hello", &make<Quantum::TesterCell::Hello>},
+    {"NeverOutput", "Creates infinite loop", &make<Quantum::NeverOutput>},
+    {"Pause", "Pause", &make<Quantum::Pause>},
+    {"Delay", "Delay without blocking a scheduler thread", &make<Quantum::Delay>},
+    {"BatchAdd", "Adds two batches of doubles", &make<Quantum::TesterCell::BatchAdd>},
+    {"BatchOperation", "Adds or subtracts two batches of doubles",
+            &make<Quantum::TesterCell::BatchOperation>},
+    {"BatchMultiplyAdd", "Fused multiply-add of three batches of doubles",
+            &make<Quantum::TesterCell::BatchMultiplyAdd>},
+    {"Broadcast", "Shares a batch with any number of consumers",
+            &make<Quantum::TesterCell::Broadcast>},
+};
 
-    Cell_<TesterCell::Hello>::SHORT_DOC = "Hello";
-    Cell_<TesterCell::Hello>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<TesterCell::Hello>::CELL_NAME = "Hello";
-    cell_ptr hello(new Cell_<TesterCell::Hello>());
-    hello->metadata["name"] << std::string("Hello");
-    cells_to_add.push_back(hello);
+}//namespace
 
-    Cell_<NeverOutput>::SHORT_DOC = "Creates infinite loop";
-    Cell_<NeverOutput>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<NeverOutput>::CELL_NAME = "NeverOutput";
-    cell_ptr never_output(new Cell_<NeverOutput>());
-    never_output->metadata["name"] << std::string("NeverOutput");
-    cells_to_add.push_back(never_output);
+namespace Quantum {
+namespace TesterCell {
 
-    Cell_<Pause>::SHORT_DOC = "Pause";
-    Cell_<Pause>::MODULE_NAME = "TesterCellPlugin";
-    Cell_<Pause>::CELL_NAME = "Pause";
-    cell_ptr pause(new Cell_<Pause>());
-    pause->metadata["name"] << std::string("Pause");
-    cells_to_add.push_back(pause);
+const CellEntry* plugin_cells(std::size_t &count)
+{
+    count = sizeof(cells) / sizeof(cells[0]);
+    return cells;
+}
 
-    for(cell_ptr c: cells_to_add)
+void register_cells(Kernel &kernel)
+{
+    register_shared_types();
+    for(const CellEntry &entry: cells)
     {
+        cell_ptr c = entry.make(entry);
         c->init();
-        kernel.getCellRegistry().addCell(c, c->metadata.get<std::string>("name"));
+        kernel.getCellRegistry().addCell(c, entry.name);
     }
 }
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#if !defined(TESTERCELLPLUGIN_STATICLIB)
+extern "C" TESTERCELL_API int getEngineVersion()
+{
+    return 1;
+}
+
+extern "C" TESTERCELL_API void registerPlugin(Quantum::Kernel &kernel)
+{
+    Quantum::TesterCell::register_cells(kernel);
+}
+#endif
@@ -10,5 +10,46 @@
 #ifndef TESTERCELL_H_
 #define TESTERCELL_H_
 
+#include "Engine/kernel.h"
+#include "testercell_config.h"
+
+#include <cstddef>
+
+namespace Quantum {
+namespace TesterCell {
+
+/**
+ * One cell type of the plugin: its registry name, short doc and a factory
+ * that sets the Cell_<T> metadata and makes an uninitialized cell.
+ */
+struct CellEntry
+{
+    const char *name;
+    const char *doc;
+    cell_ptr (*make)(const CellEntry &entry);
+};
+
+/** The cell types registerPlugin() registers, in order. */
+TESTERCELL_API const CellEntry* plugin_cells(std::size_t &count);
+
+/**
+ * Registers the socket types and cells of the plugin with kernel. This is
+ * what registerPlugin() does, and the entry point for a host linking the
+ * static library (TESTERCELLPLUGIN_STATICLIB), which has no registerPlugin()
+ * so several static plugins can be linked into one host.
+ *
+ * Every cell type is built and initialized here, not on first use: the
+ * engine's CellRegistry only accepts built cells, so startup still grows
+ * with the number of cell types.
+ */
+TESTERCELL_API void register_cells(Kernel &kernel);
+
+}//namespace TesterCell
+}//namespace Quantum
+
+#if !defined(TESTERCELLPLUGIN_STATICLIB)
+extern "C" TESTERCELL_API int getEngineVersion();
+extern "C" TESTERCELL_API void registerPlugin(Quantum::Kernel &kernel);
+#endif
 
 #endif /* TESTERCELL_H_ */